@@ -0,0 +1,249 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Counts the heap allocations made by libelemental's public functions. Each
+// function is written to standard output as one JSON object per line, with its
+// allocations and bytes allocated per call. Functions with an allocation budget
+// that exceed it are reported on standard error, and the program fails.
+
+#include "harness.hh"
+#include <libelemental/misc/macros.hh>
+#include <libelemental/misc/ucompose.hh>
+#include <libelemental/formats.hh>
+#include <libelemental/table.hh>
+#include <libelemental/value-types.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Elemental;
+
+//******************************************************************************
+// Harness
+
+
+// Each function is called this many times, after as many uncounted calls.
+static const unsigned long CALLS = 256;
+
+// Functions for which no budget is set.
+static const long NO_BUDGET = -1;
+
+static bool over_budget = false;
+
+
+// Counts the allocations of an operation, which is passed the index of each
+// call. The budget is the greatest number of allocations allowed per call.
+template<class Operation>
+static void
+account (const char* name, long budget, Operation op)
+{
+	for (unsigned long i = 0; i < CALLS; ++i)
+		op (i);
+
+	AllocationCount before = get_allocation_count ();
+	count_allocations (true);
+	for (unsigned long i = 0; i < CALLS; ++i)
+		op (i);
+	count_allocations (false);
+	AllocationCount after = get_allocation_count ();
+
+	double allocs_per_call = double (after.allocations - before.allocations)
+		/ CALLS;
+	std::printf ("{\"name\":\"%s\",\"allocs_per_call\":%.2f,"
+		"\"bytes_per_call\":%.2f", name, allocs_per_call,
+		double (after.bytes - before.bytes) / CALLS);
+	if (budget != NO_BUDGET)
+		std::printf (",\"budget\":%ld", budget);
+	std::printf ("}\n");
+
+	if (budget != NO_BUDGET && allocs_per_call > budget)
+	{
+		std::fprintf (stderr, "%s: %.2f allocations per call; budget is %ld\n",
+			name, allocs_per_call, budget);
+		over_budget = true;
+	}
+}
+
+
+// Accounts get_string() and compare() for one property's values.
+template<class T>
+static void
+account_values (const char* type, const Property<T>& property,
+	long compare_budget)
+{
+	std::vector<const T*> values;
+	CONST_FOREACH (Table, get_table (), el)
+	{
+		const T &value = (*el)->get_property (property);
+		if (value.has_value ()) values.push_back (&value);
+	}
+	if (values.empty ()) return;
+	std::size_t count = values.size ();
+
+	std::string name = std::string ("get_string/") + type;
+	account (name.c_str (), NO_BUDGET, [&] (unsigned long i)
+		{ keep (values[i % count]->get_string ()); });
+
+	name = std::string ("compare/") + type;
+	account (name.c_str (), compare_budget, [&] (unsigned long i)
+		{ keep (values[i % count]->compare (*values[(i + 1) % count])); });
+}
+
+//******************************************************************************
+
+
+int
+main ()
+{
+	count_allocations (true);
+	initialize ();
+	count_allocations (false);
+	AllocationCount initialized = get_allocation_count ();
+	std::printf ("{\"name\":\"initialize\",\"allocs_per_call\":%lu,"
+		"\"bytes_per_call\":%lu}\n", initialized.allocations,
+		initialized.bytes);
+
+	const Table &table = get_table ();
+	std::size_t count = table.size ();
+
+	// Lookups
+
+	account ("get_table", 0, [] (unsigned long)
+		{ keep (&get_table ()); });
+
+	account ("get_dataset", 0, [] (unsigned long)
+		{ keep (get_dataset ()); });
+
+	account ("get_element/number", 0, [&] (unsigned long i)
+		{ keep (&get_element (AtomicNumber (i % count + 1))); });
+
+	std::vector<std::string> symbols;
+	CONST_FOREACH (Table, table, el)
+		symbols.push_back ((*el)->symbol);
+	account ("get_element/symbol", 0, [&] (unsigned long i)
+		{ keep (&get_element (symbols[i % count])); });
+
+	std::vector<const PropertyBase*> properties;
+	CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+		CONST_FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+			properties.push_back (*prop);
+	std::size_t property_count = properties.size ();
+
+	account ("get_property", 0, [&] (unsigned long i)
+		{ keep (&get_property (properties[i % property_count]->get_key ())); });
+
+	account ("get_category", 0, [] (unsigned long)
+		{ keep (&get_category ("thermal")); });
+
+	account ("Element::get_property_base", 0, [&] (unsigned long i)
+		{
+			const PropertyBase *property = properties[i % property_count];
+			if (property != &P_SYMBOL && property != &P_NUMBER)
+				keep (&table[i % count]->get_property_base (*property));
+		});
+
+	account ("Element::get_property", 0, [&] (unsigned long i)
+		{ keep (&table[i % count]->get_property (P_MELTING_POINT)); });
+
+	account ("Element::get_phase", 0, [&] (unsigned long i)
+		{ keep (table[i % count]->get_phase ()); });
+
+	// Properties
+
+	account ("PropertyBase::get_name", NO_BUDGET, [&] (unsigned long i)
+		{ keep (properties[i % property_count]->get_name ()); });
+
+	account ("PropertyBase::get_unit", NO_BUDGET, [&] (unsigned long i)
+		{ keep (properties[i % property_count]->get_unit ()); });
+
+	std::vector<const Float*> masses;
+	CONST_FOREACH (Table, table, el)
+	{
+		const Float &mass = (*el)->get_property (P_ATOMIC_MASS);
+		if (mass.has_value ()) masses.push_back (&mass);
+	}
+	account ("Property<Float>::get_scale_position", 0, [&] (unsigned long i)
+		{
+			keep (P_ATOMIC_MASS.get_scale_position
+				(*masses[i % masses.size ()], i % 2));
+		});
+
+	// Values
+
+	account_values ("Float", P_ATOMIC_MASS, 0);
+	account_values ("Int", P_GROUP, 0);
+	account_values ("String", P_OFFICIAL_NAME, NO_BUDGET);
+	account_values ("Message", P_NAME, NO_BUDGET);
+	account_values ("Event", P_DISCOVERY, 0);
+	account_values ("FloatList", P_LATTICE_EDGES, 0);
+	account_values ("IntList", P_OXIDATION_STATES, 0);
+	account_values ("Series", P_SERIES, 0);
+	account_values ("Block", P_BLOCK, 0);
+	account_values ("Phase", P_PHASE, 0);
+	account_values ("LatticeType", P_LATTICE_TYPE, 0);
+	account_values ("ColorValue", P_COLOR, 0);
+
+	account ("value_base::get_tip", NO_BUDGET, [&] (unsigned long i)
+		{ keep (table[i % count]->get_property (P_ATOMIC_MASS).get_tip ()); });
+
+	// Rendering
+
+	account ("compose::ucompose", NO_BUDGET, [] (unsigned long i)
+		{ keep (compose::ucompose ("%1 of %2", double (i) / 3.0, "elements")); });
+
+	{
+		NullBuffer null_buffer;
+		EntriesStream view (null_buffer);
+		account ("Element::make_entries/EntriesStream", NO_BUDGET,
+			[&] (unsigned long i) { table[i % count]->make_entries (view); });
+	}
+
+	{
+		std::string output;
+		output.reserve (1 << 20);
+		EntriesNDJSON view (output);
+		account ("Element::make_entries/EntriesNDJSON", NO_BUDGET,
+			[&] (unsigned long i)
+			{
+				output.clear ();
+				table[i % count]->make_entries (view);
+			});
+		account ("Element::make_entry/EntriesNDJSON", NO_BUDGET,
+			[&] (unsigned long i)
+			{
+				output.clear ();
+				table[i % count]->make_entry (view, P_DENSITY_SOLID);
+			});
+		view.finish ();
+	}
+
+	// Contexts
+
+	account ("Context::get_current", 0, [] (unsigned long)
+		{ keep (&Context::get_current ()); });
+
+	account ("Stats::count", 0, [] (unsigned long)
+		{ Stats::count (Stats::CATALOG_HIT); });
+
+	return over_budget ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Micro-benchmarks of libelemental's frequently used functions. Each benchmark
+// is written to standard output as one JSON object per line. Arguments that do
+// not begin with "--" select the benchmarks whose names contain them.
+
+#include "harness.hh"
+#include <libelemental/misc/macros.hh>
+#include <libelemental/misc/ucompose.hh>
+#include <libelemental/table.hh>
+#include <libelemental/value-types.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Elemental;
+
+//******************************************************************************
+// Harness
+
+
+typedef std::chrono::steady_clock Clock;
+
+// Each benchmark is timed in this many samples of equal numbers of operations.
+static unsigned int samples = 200;
+
+// Each sample lasts about this long.
+static const double SAMPLE_NS = 50000.0;
+
+static std::vector<std::string> filters;
+
+
+static bool
+is_selected (const char* name)
+{
+	if (filters.empty ()) return true;
+	CONST_FOREACH (std::vector<std::string>, filters, filter)
+		if (std::strstr (name, filter->c_str ()) != NULL)
+			return true;
+	return false;
+}
+
+
+static void
+report (const char* name, unsigned long iterations, double mean,
+	std::vector<double>& per_op, double allocs_per_op)
+{
+	std::sort (per_op.begin (), per_op.end ());
+	std::size_t last = per_op.size () - 1;
+
+	std::printf ("{\"name\":\"%s\",\"iterations\":%lu,\"ns_per_op\":%.2f,"
+		"\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f,\"max\":%.2f,"
+		"\"allocs_per_op\":%.2f}\n", name, iterations, mean,
+		per_op[last / 2], per_op[last * 9 / 10], per_op[last * 99 / 100],
+		per_op[last], allocs_per_op);
+	std::fflush (stdout);
+}
+
+
+// Times an operation, which is passed the index of each call.
+template<class Operation>
+static void
+bench (const char* name, Operation op)
+{
+	if (!is_selected (name)) return;
+
+	// Warm up, and size the samples from the warm-up rate.
+	unsigned long batch = 1000;
+	Clock::time_point start = Clock::now ();
+	for (unsigned long i = 0; i < batch; ++i)
+		op (i);
+	double warmup = std::chrono::duration<double, std::nano>
+		(Clock::now () - start).count ();
+	batch = std::max (1ul, (unsigned long) (SAMPLE_NS / (warmup / batch)));
+
+	std::vector<double> per_op;
+	per_op.reserve (samples);
+	double total = 0.0;
+	unsigned long before = get_allocation_count ().allocations;
+
+	for (unsigned int sample = 0; sample < samples; ++sample)
+	{
+		start = Clock::now ();
+		for (unsigned long i = 0; i < batch; ++i)
+			op (sample * batch + i);
+		double elapsed = std::chrono::duration<double, std::nano>
+			(Clock::now () - start).count ();
+		per_op.push_back (elapsed / batch);
+		total += elapsed;
+	}
+
+	unsigned long iterations = batch * samples;
+	unsigned long allocated = get_allocation_count ().allocations - before;
+	report (name, iterations, total / iterations, per_op,
+		double (allocated) / iterations);
+}
+
+//******************************************************************************
+// Benchmarks
+
+
+// Benchmarks get_string() and compare() for one property's values.
+template<class T>
+static void
+bench_values (const char* type, const Property<T>& property)
+{
+	std::vector<const T*> values;
+	CONST_FOREACH (Table, get_table (), el)
+	{
+		const T &value = (*el)->get_property (property);
+		if (value.has_value ()) values.push_back (&value);
+	}
+	if (values.empty ()) return;
+	std::size_t count = values.size ();
+
+	std::string name = std::string ("get_string/") + type;
+	bench (name.c_str (), [&] (unsigned long i)
+		{ keep (values[i % count]->get_string ()); });
+
+	name = std::string ("compare/") + type;
+	bench (name.c_str (), [&] (unsigned long i)
+		{ keep (values[i % count]->compare (*values[(i + 1) % count])); });
+}
+
+
+int
+main (int argc, char** argv)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strncmp (argv[i], "--samples=", 10) == 0)
+			samples = std::max (1, std::atoi (argv[i] + 10));
+		else
+			filters.push_back (argv[i]);
+	}
+
+	count_allocations (true);
+
+	if (is_selected ("initialize"))
+	{
+		unsigned long before = get_allocation_count ().allocations;
+		Clock::time_point start = Clock::now ();
+		initialize ();
+		double elapsed = std::chrono::duration<double, std::nano>
+			(Clock::now () - start).count ();
+		std::vector<double> once (1, elapsed);
+		report ("initialize", 1, elapsed, once,
+			double (get_allocation_count ().allocations - before));
+
+		bench ("initialize/again", [] (unsigned long) { initialize (); });
+	}
+	else
+		initialize ();
+
+	const Table &table = get_table ();
+	std::size_t count = table.size ();
+
+	bench ("get_element/number", [&] (unsigned long i)
+		{ keep (&get_element (AtomicNumber (i % count + 1))); });
+
+	std::vector<std::string> symbols;
+	CONST_FOREACH (Table, table, el)
+		symbols.push_back ((*el)->symbol);
+	bench ("get_element/symbol", [&] (unsigned long i)
+		{ keep (&get_element (symbols[i % count])); });
+
+	std::vector<const PropertyBase*> properties;
+	CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+		CONST_FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+			if (*prop != &P_SYMBOL && *prop != &P_NUMBER)
+				properties.push_back (*prop);
+	bench ("get_property_base", [&] (unsigned long i)
+		{
+			keep (&table[i % count]->get_property_base
+				(*properties[i % properties.size ()]));
+		});
+
+	bench_values ("Float", P_ATOMIC_MASS);
+	bench_values ("Int", P_GROUP);
+	bench_values ("String", P_OFFICIAL_NAME);
+	bench_values ("Message", P_NAME);
+	bench_values ("Event", P_DISCOVERY);
+	bench_values ("FloatList", P_LATTICE_EDGES);
+	bench_values ("IntList", P_OXIDATION_STATES);
+	bench_values ("Series", P_SERIES);
+	bench_values ("Block", P_BLOCK);
+	bench_values ("Phase", P_PHASE);
+	bench_values ("LatticeType", P_LATTICE_TYPE);
+	bench_values ("ColorValue", P_COLOR);
+
+	{
+		NullBuffer null_buffer;
+		EntriesStream view (null_buffer);
+		const ustring name ("Density"), value ("7.874 g/cm<sup>3</sup>");
+		bench ("EntriesStream::entry", [&] (unsigned long)
+			{ view.entry (name, value); });
+	}
+
+	bench ("UComposition", [] (unsigned long i)
+		{
+			keep (compose::UComposition ("%1 of %2").arg (double (i) / 3.0)
+				.arg ("elements").str ());
+		});
+
+	std::vector<const Float*> masses;
+	CONST_FOREACH (Table, table, el)
+	{
+		const Float &mass = (*el)->get_property (P_ATOMIC_MASS);
+		if (mass.has_value ()) masses.push_back (&mass);
+	}
+	bench ("get_scale_position", [&] (unsigned long i)
+		{
+			keep (P_ATOMIC_MASS.get_scale_position
+				(*masses[i % masses.size ()], i % 2));
+		});
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that compose::ucompose() composes every format string and set of
+// arguments as compose::UComposition does, in the "C" locale and in a locale
+// which groups digits and has a decimal comma.
+
+#include <libelemental/misc/ucompose.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <locale>
+#include <string>
+
+using compose::UComposition;
+using compose::ucompose;
+
+static unsigned int failures = 0;
+
+
+template<typename... T>
+static void
+check (const char* fmt, const T&... args)
+{
+	UComposition composition (fmt);
+	(composition.arg (args), ...);
+	Glib::ustring expected = composition.str (),
+		composed = ucompose (fmt, args...),
+		composed_ustring = ucompose (Glib::ustring (fmt), args...);
+
+	if (composed != expected || composed_ustring != expected)
+	{
+		std::fprintf (stderr, "FAIL: \"%s\" gave \"%s\"; UComposition gave "
+			"\"%s\"\n", fmt, (composed != expected ? composed : composed_ustring)
+			.c_str (), expected.c_str ());
+		++failures;
+	}
+}
+
+
+// Groups digits by thousands with a period, and uses a decimal comma.
+class GroupingPunct
+:	public std::numpunct<wchar_t>
+{
+protected:
+
+	virtual wchar_t do_decimal_point () const { return L','; }
+	virtual wchar_t do_thousands_sep () const { return L'.'; }
+	virtual std::string do_grouping () const { return "\3"; }
+};
+
+
+static void
+check_all ()
+{
+	// Plain text and %%
+	check ("no specs", 1);
+	check ("100%%", 1);
+	check ("%%1 is not a spec, but %1 is", 1);
+	check ("%%%1%%", 1);
+	check ("a trailing %", 1);
+	check ("%", 1);
+	check ("%x %1 %-", 1);
+
+	// Repeated and reordered specs
+	check ("%1 %1 %1", "echo");
+	check ("%2, %1", "first", "second");
+	check ("%1%2%1%2", 'a', 'b');
+	check ("%3 %2 %1 %2 %3", 1, 2, 3);
+	check ("%10 %1", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+
+	// Unknown specs
+	check ("%0 and %1", "one");
+	check ("%1 and %2", "one");
+	check ("%9%1%12", "one", "two");
+	check ("%99999999999999999999 %1", "one");
+
+	// Empty arguments are skipped, so that the next takes their number.
+	check ("%1-%2", "", "a", "b");
+	check ("%1-%2-%3", "a", std::string (), "b", Glib::ustring ("c"));
+	check ("[%1]", "");
+	check ("[%1][%2]", Glib::ustring (), "");
+
+	// Strings
+	check ("%1 %2 %3", std::string ("string"), Glib::ustring ("ustring"),
+		"char array");
+	check ("%1", Glib::ustring ("\xc3\x85ngstr\xc3\xb6m"));
+
+	// Numbers
+	check ("%1 %2 %3 %4", 0, -42, 1234567, 4294967295u);
+	check ("%1 %2", -9223372036854775807L, 18446744073709551615ul);
+	check ("%1 %2 %3 %4", 0.1, -2.5, 1234.5, 1e20);
+	check ("%1 %2 %3", 1e-7, 123456789.0, 3.0f);
+	check ("%1 %2", true, false);
+}
+
+
+int
+main ()
+{
+	std::locale::global (std::locale::classic ());
+	check_all ();
+
+	std::locale::global (std::locale (std::locale::classic (),
+		new GroupingPunct));
+	check_all ();
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
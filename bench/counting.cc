@@ -0,0 +1,310 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Both operator new and, where the C library provides its own allocator under
+// another name (as glibc does), the C allocation functions are replaced, so
+// that allocations made by glib and glibmm are also counted. Each calls that
+// underlying allocator, so that no allocation is counted twice. Elsewhere only
+// operator new is counted; "make check" then skips the allocation budgets.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "harness.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef HAVE___LIBC_MALLOC
+
+extern "C" void* __libc_malloc (std::size_t size);
+extern "C" void* __libc_calloc (std::size_t count, std::size_t size);
+extern "C" void* __libc_realloc (void* ptr, std::size_t size);
+extern "C" void* __libc_memalign (std::size_t alignment, std::size_t size);
+extern "C" void __libc_free (void* ptr);
+
+static inline void*
+allocate (std::size_t size)
+{
+	return __libc_malloc (size);
+}
+
+static inline void*
+allocate_aligned (std::size_t size, std::size_t alignment)
+{
+	return __libc_memalign (alignment, size);
+}
+
+static inline void
+release (void* ptr)
+{
+	__libc_free (ptr);
+}
+
+#else // !HAVE___LIBC_MALLOC
+
+static inline void*
+allocate (std::size_t size)
+{
+	return std::malloc (size);
+}
+
+static inline void*
+allocate_aligned (std::size_t size, std::size_t alignment)
+{
+	// aligned_alloc requires a size which is a multiple of the alignment.
+	return std::aligned_alloc (alignment,
+		(size + alignment - 1) / alignment * alignment);
+}
+
+static inline void
+release (void* ptr)
+{
+	std::free (ptr);
+}
+
+#endif // HAVE___LIBC_MALLOC
+
+static std::atomic<bool> counting (false);
+static std::atomic<unsigned long> allocations (0);
+static std::atomic<unsigned long> bytes (0);
+
+
+static inline void
+count_allocation (std::size_t size)
+{
+	if (counting.load (std::memory_order_relaxed))
+	{
+		allocations.fetch_add (1, std::memory_order_relaxed);
+		bytes.fetch_add (size, std::memory_order_relaxed);
+	}
+}
+
+
+void
+count_allocations (bool on)
+{
+	counting.store (on, std::memory_order_relaxed);
+}
+
+
+AllocationCount
+get_allocation_count ()
+{
+	AllocationCount result;
+	result.allocations = allocations.load (std::memory_order_relaxed);
+	result.bytes = bytes.load (std::memory_order_relaxed);
+	return result;
+}
+
+//******************************************************************************
+// C allocation functions
+
+#ifdef HAVE___LIBC_MALLOC
+
+
+extern "C" void*
+malloc (std::size_t size)
+{
+	count_allocation (size);
+	return __libc_malloc (size);
+}
+
+
+extern "C" void*
+calloc (std::size_t count, std::size_t size)
+{
+	count_allocation (count * size);
+	return __libc_calloc (count, size);
+}
+
+
+extern "C" void*
+realloc (void* ptr, std::size_t size)
+{
+	count_allocation (size);
+	return __libc_realloc (ptr, size);
+}
+
+
+extern "C" void
+free (void* ptr)
+{
+	__libc_free (ptr);
+}
+
+#endif // HAVE___LIBC_MALLOC
+
+//******************************************************************************
+// C++ allocation functions
+
+
+void*
+operator new (std::size_t size)
+{
+	count_allocation (size);
+	if (void *result = allocate (size ? size : 1))
+		return result;
+	throw std::bad_alloc ();
+}
+
+
+void*
+operator new[] (std::size_t size)
+{
+	return operator new (size);
+}
+
+
+void*
+operator new (std::size_t size, const std::nothrow_t&) throw ()
+{
+	count_allocation (size);
+	return allocate (size ? size : 1);
+}
+
+
+void*
+operator new[] (std::size_t size, const std::nothrow_t& nothrow) throw ()
+{
+	return operator new (size, nothrow);
+}
+
+
+void*
+operator new (std::size_t size, std::align_val_t alignment)
+{
+	count_allocation (size);
+	if (void *result = allocate_aligned (size ? size : 1,
+			std::size_t (alignment)))
+		return result;
+	throw std::bad_alloc ();
+}
+
+
+void*
+operator new[] (std::size_t size, std::align_val_t alignment)
+{
+	return operator new (size, alignment);
+}
+
+
+void*
+operator new (std::size_t size, std::align_val_t alignment,
+	const std::nothrow_t&) throw ()
+{
+	count_allocation (size);
+	return allocate_aligned (size ? size : 1, std::size_t (alignment));
+}
+
+
+void*
+operator new[] (std::size_t size, std::align_val_t alignment,
+	const std::nothrow_t& nothrow) throw ()
+{
+	return operator new (size, alignment, nothrow);
+}
+
+
+void
+operator delete (void* ptr) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete (void* ptr, std::size_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr, std::size_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete (void* ptr, const std::nothrow_t&) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr, const std::nothrow_t&) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete (void* ptr, std::align_val_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr, std::align_val_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete (void* ptr, std::size_t, std::align_val_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr, std::size_t, std::align_val_t) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete (void* ptr, std::align_val_t, const std::nothrow_t&) throw ()
+{
+	release (ptr);
+}
+
+
+void
+operator delete[] (void* ptr, std::align_val_t, const std::nothrow_t&)
+	throw ()
+{
+	release (ptr);
+}
@@ -0,0 +1,250 @@
+/*
+ * This file is part of gElemental, a periodic table viewer with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Starts elementald on a socket in a temporary directory and checks its
+// answers to valid, invalid and oversized requests. Also checks that the
+// daemon removes its socket when stopped and refuses to replace a file which
+// is not a socket.
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef ELEMENTALD
+#define ELEMENTALD "../src/elementald"
+#endif
+
+static unsigned int failures = 0;
+
+
+static void
+check (bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::fprintf (stderr, "FAIL: %s\n", what);
+		++failures;
+	}
+}
+
+
+static pid_t
+start_daemon (const std::string& path)
+{
+	pid_t pid = fork ();
+	if (pid == 0)
+	{
+		execl (ELEMENTALD, "elementald", "--socket", path.c_str (),
+			(char*) NULL);
+		_exit (127);
+	}
+	return pid;
+}
+
+
+// Connects to the daemon, waiting up to five seconds for it to start.
+static int
+connect_to (const std::string& path)
+{
+	sockaddr_un address;
+	std::memset (&address, 0, sizeof address);
+	address.sun_family = AF_UNIX;
+	std::strncpy (address.sun_path, path.c_str (),
+		sizeof address.sun_path - 1);
+
+	for (unsigned int attempt = 0; attempt < 500; ++attempt)
+	{
+		int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+		if (fd < 0) break;
+		if (connect (fd, (sockaddr*) &address, sizeof address) == 0)
+			return fd;
+		close (fd);
+		usleep (10000);
+	}
+
+	std::fprintf (stderr, "cannot connect to \"%s\"\n", path.c_str ());
+	std::exit (EXIT_FAILURE);
+}
+
+
+// Waits up to five seconds for the daemon to exit, then kills it.
+static bool
+wait_for (pid_t pid, int& status)
+{
+	for (unsigned int attempt = 0; attempt < 500; ++attempt)
+	{
+		if (waitpid (pid, &status, WNOHANG) == pid)
+			return true;
+		usleep (10000);
+	}
+
+	kill (pid, SIGKILL);
+	waitpid (pid, &status, 0);
+	return false;
+}
+
+
+static bool
+send_all (int fd, const std::string& data)
+{
+	std::string::size_type sent = 0;
+	while (sent < data.size ())
+	{
+		ssize_t written = write (fd, data.data () + sent, data.size () - sent);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return false;
+		sent += written;
+	}
+	return true;
+}
+
+
+// Reads one response: a header line, and the output whose length an OK header
+// gives. Returns what was read before the end of the stream, if any.
+static std::string
+receive (int fd)
+{
+	std::string response;
+	char ch;
+	while (read (fd, &ch, 1) == 1)
+	{
+		response += ch;
+		if (ch == '\n') break;
+	}
+
+	if (response.compare (0, 3, "OK ") == 0)
+	{
+		std::string::size_type length =
+			std::strtoul (response.c_str () + 3, NULL, 10);
+		std::string body (length, '\0');
+		std::string::size_type received = 0;
+		while (received < length)
+		{
+			ssize_t count = read (fd, &body[received], length - received);
+			if (count <= 0) break;
+			received += count;
+		}
+		response.append (body, 0, received);
+	}
+
+	return response;
+}
+
+
+static std::string
+request (int fd, const std::string& line)
+{
+	send_all (fd, line + '\n');
+	return receive (fd);
+}
+
+
+static bool
+starts_with (const std::string& text, const char* prefix)
+{
+	return text.compare (0, std::strlen (prefix), prefix) == 0;
+}
+
+
+int
+main ()
+{
+	std::signal (SIGPIPE, SIG_IGN);
+
+	const char *tmpdir = std::getenv ("TMPDIR");
+	std::string pattern = std::string ((tmpdir != NULL && *tmpdir != '\0')
+		? tmpdir : "/tmp") + "/elementald-test-XXXXXX";
+	if (mkdtemp (&pattern[0]) == NULL)
+	{
+		std::perror ("mkdtemp");
+		return EXIT_FAILURE;
+	}
+	const std::string directory = pattern, path = directory + "/socket",
+		file = directory + "/file";
+
+	pid_t daemon = start_daemon (path);
+	int fd = connect_to (path);
+
+	check (request (fd, "PING") == "OK 0\n", "PING");
+
+	std::string iron = request (fd, "ELEMENT Fe json");
+	check (starts_with (iron, "OK ") &&
+		iron.find ("\"symbol\":{\"value\":\"Fe\"}") != std::string::npos,
+		"ELEMENT Fe json");
+	check (request (fd, "ELEMENT 26 json") == iron, "ELEMENT 26 json");
+	check (request (fd, "ELEMENT Fe json") == iron, "cached ELEMENT Fe json");
+
+	std::string melting = request (fd, "PROPERTY Fe melting_point csv");
+	check (starts_with (melting, "OK ") &&
+		melting.find ("melting_point") != std::string::npos,
+		"PROPERTY Fe melting_point csv");
+
+	check (starts_with (request (fd, "ELEMENT Xx"), "ERR "), "unknown element");
+	check (starts_with (request (fd, "PROPERTY Fe nonsense"), "ERR "),
+		"unknown property");
+	check (starts_with (request (fd, "ELEMENT Fe xml"), "ERR "),
+		"unknown format");
+	check (starts_with (request (fd, "ELEMENT Fe text no_such_LOCALE"),
+		"ERR "), "unknown locale");
+	check (starts_with (request (fd, "FROB"), "ERR "), "unknown command");
+	close (fd);
+
+	// An oversized request is refused and its connection closed.
+	fd = connect_to (path);
+	send_all (fd, std::string (8192, 'x'));
+	check (starts_with (receive (fd), "ERR "), "oversized request");
+	char ch;
+	check (read (fd, &ch, 1) == 0, "connection closed after oversized request");
+	close (fd);
+
+	fd = connect_to (path);
+	check (request (fd, "PING") == "OK 0\n", "PING after oversized request");
+	close (fd);
+
+	int status;
+	kill (daemon, SIGTERM);
+	check (wait_for (daemon, status) && WIFEXITED (status) &&
+		WEXITSTATUS (status) == 0, "daemon stopped");
+	struct stat info;
+	check (lstat (path.c_str (), &info) != 0, "socket removed");
+
+	// A file which is not a socket is not replaced.
+	std::FILE *created = std::fopen (file.c_str (), "w");
+	if (created != NULL) std::fclose (created);
+	daemon = start_daemon (file);
+	check (wait_for (daemon, status) && WIFEXITED (status) &&
+		WEXITSTATUS (status) != 0, "daemon refused a regular file");
+	check (lstat (file.c_str (), &info) == 0 && S_ISREG (info.st_mode),
+		"regular file kept");
+
+	unlink (file.c_str ());
+	unlink (path.c_str ());
+	rmdir (directory.c_str ());
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
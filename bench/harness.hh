@@ -0,0 +1,65 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH__HARNESS_HH
+#define BENCH__HARNESS_HH
+
+#include <streambuf>
+
+//******************************************************************************
+
+// Keeps the compiler from discarding a result.
+template<class T>
+static inline void
+keep (const T& value)
+{
+	asm volatile ("" : : "g" (&value) : "memory");
+}
+
+//******************************************************************************
+
+// Writes nothing.
+class NullBuffer
+:	public std::streambuf
+{
+protected:
+
+	virtual int_type overflow (int_type ch) { return ch; }
+	virtual std::streamsize xsputn (const char*, std::streamsize count)
+		{ return count; }
+};
+
+//******************************************************************************
+// Allocation accounting, defined in counting.cc
+
+// Heap allocations made through operator new and the C allocation functions.
+struct AllocationCount
+{
+	unsigned long allocations;
+	unsigned long bytes;
+};
+
+// Turns counting on or off. Allocations are not counted until it is on.
+void count_allocations (bool on);
+
+// Returns the totals counted so far.
+AllocationCount get_allocation_count ();
+
+#endif // BENCH__HARNESS_HH
@@ -0,0 +1,173 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that SplitView, strsplit_view() and ustrsplit_view() give the pieces
+// that strsplit() and ustrsplit() give, and that strstrip_view() and
+// ustrstrip_view() strip the expected whitespace.
+
+#include <libelemental/misc/extras.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace misc;
+
+static unsigned int failures = 0;
+
+
+static std::string
+describe (const std::vector<std::string_view>& pieces)
+{
+	std::string result = "{";
+	for (std::vector<std::string_view>::const_iterator piece = pieces.begin ();
+		piece != pieces.end (); ++piece)
+	{
+		if (piece != pieces.begin ()) result += ", ";
+		result += '"';
+		result += *piece;
+		result += '"';
+	}
+	return result + '}';
+}
+
+
+static void
+fail (const char* function, const char* data, const char* delimiter,
+	unsigned int max_tokens, const std::vector<std::string_view>& pieces,
+	const std::vector<std::string_view>& expected)
+{
+	std::fprintf (stderr, "FAIL: %s (\"%s\", \"%s\", %u) gave %s, not %s\n",
+		function, data, delimiter, max_tokens, describe (pieces).c_str (),
+		describe (expected).c_str ());
+	++failures;
+}
+
+
+// Checks both the lazy and the eager split against the expected pieces and
+// against the copying split.
+static void
+check_split (bool utf8, const char* data, const char* delimiter,
+	unsigned int max_tokens, std::initializer_list<const char*> pieces)
+{
+	std::vector<std::string_view> expected (pieces.begin (), pieces.end ());
+
+	SplitView view = utf8 ? usplit_view (data, delimiter, max_tokens)
+		: split_view (data, delimiter, max_tokens);
+	std::vector<std::string_view> lazy;
+	for (SplitView::const_iterator piece = view.begin ();
+		piece != view.end (); ++piece)
+		lazy.push_back (*piece);
+	if (lazy != expected)
+		fail (utf8 ? "usplit_view" : "split_view", data, delimiter, max_tokens,
+			lazy, expected);
+
+	std::vector<std::string_view> eager = utf8
+		? ustrsplit_view (data, delimiter, max_tokens)
+		: strsplit_view (data, delimiter, max_tokens);
+	if (eager != expected)
+		fail (utf8 ? "ustrsplit_view" : "strsplit_view", data, delimiter,
+			max_tokens, eager, expected);
+
+	std::vector<std::string> copies;
+	if (utf8)
+	{
+		std::vector<ustring> split = ustrsplit (data, delimiter, max_tokens);
+		copies.assign (split.begin (), split.end ());
+	}
+	else
+		copies = strsplit (data, delimiter, max_tokens);
+	std::vector<std::string_view> copied (copies.begin (), copies.end ());
+	if (copied != expected)
+		fail (utf8 ? "ustrsplit" : "strsplit", data, delimiter, max_tokens,
+			copied, expected);
+}
+
+
+static void
+check_strip (bool utf8, const char* data, const char* expected)
+{
+	std::string_view stripped = utf8 ? ustrstrip_view (data)
+		: strstrip_view (data);
+	if (stripped != expected)
+	{
+		std::fprintf (stderr, "FAIL: %s (\"%s\") gave \"%s\", not \"%s\"\n",
+			utf8 ? "ustrstrip_view" : "strstrip_view", data,
+			std::string (stripped).c_str (), expected);
+		++failures;
+	}
+}
+
+
+int
+main ()
+{
+	for (int utf8 = 0; utf8 < 2; ++utf8)
+	{
+		// Empty input has no pieces; empty pieces are kept elsewhere.
+		check_split (utf8, "", ",", 0, {});
+		check_split (utf8, "", "", 0, {});
+		check_split (utf8, "", ",", 2, {});
+		check_split (utf8, "abc", "", 0, {"abc"});
+		check_split (utf8, ",", ",", 0, {"", ""});
+		check_split (utf8, "a,b,,c,", ",", 0, {"a", "b", "", "c", ""});
+
+		// The last piece holds the remainder once max_tokens is reached.
+		check_split (utf8, "a,b,c", ",", 1, {"a,b,c"});
+		check_split (utf8, "a,b,c", ",", 2, {"a", "b,c"});
+		check_split (utf8, "a,b,c", ",", 3, {"a", "b", "c"});
+		check_split (utf8, "a,b,c", ",", 4, {"a", "b", "c"});
+		check_split (utf8, ",,", ",", 2, {"", ","});
+
+		// A delimiter of several characters splits at any one of them.
+		check_split (utf8, "a,b;c d", ",; ", 0, {"a", "b", "c", "d"});
+		check_split (utf8, "a;,b", ",;", 0, {"a", "", "b"});
+		check_split (utf8, "a;,b", ",;", 2, {"a", ",b"});
+	}
+
+	// A UTF-8 delimiter splits at whole characters only.
+	check_split (true, "\xce\xb1\xc2\xb7\xce\xb2\xc2\xb7\xce\xb3",
+		"\xc2\xb7", 0, {"\xce\xb1", "\xce\xb2", "\xce\xb3"});
+	check_split (true, "\xce\xb1\xc2\xb7\xce\xb2\xc2\xb7\xce\xb3",
+		"\xc2\xb7", 2, {"\xce\xb1", "\xce\xb2\xc2\xb7\xce\xb3"});
+	check_split (true, "a\xc2\xb7" "b,c", "\xc2\xb7,", 0, {"a", "b", "c"});
+	check_split (true, "caf\xc3\xa9", "\xc3\xa8", 0, {"caf\xc3\xa9"});
+	check_split (false, "caf\xc3\xa9", "\xc3\xa8", 0, {"caf", "\xa9"});
+
+	// ASCII whitespace
+	check_strip (false, "", "");
+	check_strip (false, " \t\r\n", "");
+	check_strip (false, " \ta b\n", "a b");
+	check_strip (false, "ab", "ab");
+	check_strip (true, "", "");
+	check_strip (true, " \ta b\n", "a b");
+
+	// Unicode whitespace: no-break space, em space and ideographic space
+	check_strip (false, "\xc2\xa0x\xc2\xa0", "\xc2\xa0x\xc2\xa0");
+	check_strip (true, "\xc2\xa0x\xc2\xa0", "x");
+	check_strip (true, "\xe3\x80\x80 x y\xe2\x80\x83\n", "x y");
+	check_strip (true, "\xe2\x80\x83\xc2\xa0 ", "");
+	check_strip (true, "caf\xc3\xa9", "caf\xc3\xa9");
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Calls initialize() from many threads at once, then reads elements and their
+// properties from all of them, with and without pins, while another thread
+// publishes new datasets, which are freed once no reader needs them. The
+// program fails if any thread reads an element other than the one it asked for.
+// Races are reported when libelemental and this program are built with
+// -fsanitize=thread.
+
+#include "harness.hh"
+#include <libelemental/misc/macros.hh>
+#include <libelemental/table.hh>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Elemental;
+
+static const unsigned int THREADS = 8;
+static const unsigned int ROUNDS = 200;
+static const unsigned int PUBLISHES = 20;
+
+static std::atomic<unsigned int> waiting (THREADS);
+static std::atomic<unsigned long> errors (0);
+
+
+static void
+hammer (unsigned int index)
+{
+	// Release every thread at once, so that the first calls race.
+	--waiting;
+	while (waiting.load () != 0)
+		std::this_thread::yield ();
+
+	initialize ();
+
+	for (unsigned int round = 0; round < ROUNDS; ++round)
+	{
+		Dataset::Ptr dataset = get_dataset ();
+		const Table &table = dataset->get_table ();
+
+		for (AtomicNumber number = 1; number <= table.size (); ++number)
+		{
+			const Element &by_number = dataset->get_element
+				(AtomicNumber ((number + index) % table.size () + 1));
+			const Element &by_symbol = dataset->get_element (by_number.symbol);
+			if (&by_symbol != &by_number)
+				++errors;
+
+			CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+				CONST_FOREACH (std::list<PropertyBase*>, (*category)->properties,
+						prop)
+					if (*prop != &P_SYMBOL && *prop != &P_NUMBER)
+						keep (&by_number.get_property_base (**prop));
+
+			const Float &mass = by_number.get_property (P_ATOMIC_MASS);
+			if (mass.has_value ())
+				keep (P_ATOMIC_MASS.get_scale_position (*dataset, mass));
+		}
+
+		// Unpinned lookups are kept alive by the thread's own pin, which is
+		// renewed as new datasets are published.
+		for (AtomicNumber number = 1; number <= get_table ().size (); ++number)
+		{
+			const Element &el = get_element (number);
+			if (el.number != number)
+				++errors;
+			keep (P_ATOMIC_MASS.is_scale_valid ());
+		}
+	}
+}
+
+
+static void
+publish ()
+{
+	for (unsigned int count = 0; count < PUBLISHES; ++count)
+	{
+		DatasetBuilder builder;
+		builder.set (1, P_MELTING_POINT, Float (count));
+		publish_dataset (builder.build ());
+	}
+}
+
+
+int
+main ()
+{
+	std::vector<std::thread> threads;
+	for (unsigned int index = 0; index < THREADS; ++index)
+		threads.push_back (std::thread (hammer, index));
+	threads.push_back (std::thread (publish));
+	FOREACH (std::vector<std::thread>, threads, thread)
+		thread->join ();
+
+	if (errors.load () != 0)
+	{
+		std::fprintf (stderr, "%lu lookups returned the wrong element\n",
+			errors.load ());
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
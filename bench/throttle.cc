@@ -0,0 +1,262 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks misc::Throttle in a main loop. Several threads post numbered actions
+// to two throttles at once; each thread's actions must all be called, in the
+// order that thread posted them. How many times the main loop is woken is not
+// checked, since posts may be drained in any number of bursts. Then actions of
+// known cost are queued in ADAPTIVE mode; the effective threshold must keep
+// within its bounds and near the cost divided by the load.
+
+#include <libelemental/misc/throttle.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <glibmm/init.h>
+#include <glibmm/main.h>
+#include <glibmm/timer.h>
+#include <sigc++/adaptors/bind.h>
+#include <sigc++/functors/ptr_fun.h>
+
+using misc::Throttle;
+
+// The greatest time in seconds that any check may take.
+static const double DEADLINE = 60.0;
+
+static unsigned int failures = 0;
+
+static Glib::RefPtr<Glib::MainLoop> loop;
+static Glib::Timer elapsed;
+
+// Returns true while a check should keep waiting.
+static sigc::slot<bool> waiting;
+
+
+static bool
+on_poll ()
+{
+	if (waiting () && elapsed.elapsed () < DEADLINE)
+		return true;
+	loop->quit ();
+	return false;
+}
+
+
+// Runs the main loop until waiting_ returns false or the deadline passes.
+static void
+run_until (const sigc::slot<bool>& waiting_)
+{
+	waiting = waiting_;
+	elapsed.start ();
+	Glib::signal_timeout ().connect (sigc::ptr_fun (&on_poll), 10);
+	loop->run ();
+	elapsed.stop ();
+}
+
+//******************************************************************************
+// Posting from several threads
+
+
+static const unsigned int POSTERS = 4;
+static const unsigned int POSTS = 20000;
+
+// The numbers of the actions called, by poster. Only the main loop's thread
+// touches these.
+static std::vector<unsigned int> received[POSTERS];
+static unsigned int received_total = 0;
+
+
+static void
+receive (unsigned int poster, unsigned int number)
+{
+	received[poster].push_back (number);
+	++received_total;
+}
+
+
+static void
+post_all (Throttle* throttle, unsigned int poster)
+{
+	for (unsigned int number = 0; number < POSTS; ++number)
+		throttle->post (sigc::bind (sigc::ptr_fun (&receive), poster, number),
+			false);
+}
+
+
+static bool
+receiving ()
+{
+	return received_total < POSTERS * POSTS;
+}
+
+
+static void
+check_post ()
+{
+	Throttle first (Throttle::OPEN), second (Throttle::OPEN);
+
+	std::vector<std::thread> posters;
+	for (unsigned int poster = 0; poster < POSTERS; ++poster)
+		posters.push_back (std::thread (post_all,
+			(poster % 2) ? &second : &first, poster));
+
+	run_until (sigc::ptr_fun (&receiving));
+
+	for (std::vector<std::thread>::iterator poster = posters.begin ();
+		poster != posters.end (); ++poster)
+		poster->join ();
+
+	for (unsigned int poster = 0; poster < POSTERS; ++poster)
+	{
+		if (received[poster].size () != POSTS)
+		{
+			std::fprintf (stderr, "FAIL: %zu of %u actions posted by thread "
+				"%u were called\n", received[poster].size (), POSTS, poster);
+			++failures;
+		}
+
+		for (unsigned int number = 0; number < received[poster].size ();
+			++number)
+			if (received[poster][number] != number)
+			{
+				std::fprintf (stderr, "FAIL: action %u posted by thread %u "
+					"was called in place of action %u\n",
+					received[poster][number], poster, number);
+				++failures;
+				break;
+			}
+	}
+}
+
+//******************************************************************************
+// ADAPTIVE mode
+
+
+static const unsigned int ADAPTIVE_ACTIONS = 8;
+
+// Times are read from the steady clock, in seconds.
+typedef std::chrono::duration<double> Seconds;
+static std::vector<std::chrono::steady_clock::time_point> called;
+
+
+// Takes about the indicated time, as a busy action would.
+static void
+spend (double cost)
+{
+	std::chrono::steady_clock::time_point start =
+		std::chrono::steady_clock::now ();
+	called.push_back (start);
+	while (Seconds (std::chrono::steady_clock::now () - start).count () < cost)
+		;
+}
+
+
+static bool
+calling ()
+{
+	return called.size () < ADAPTIVE_ACTIONS;
+}
+
+
+// Checks a throttle whose actions cost the indicated time. The effective
+// threshold must end between expected and twice that, where expected is the
+// cost divided by the load within the bounds; when a bound applies, it must be
+// exactly that bound.
+static void
+check_adaptive (double cost, double load, double minimum, double maximum)
+{
+	Throttle throttle;
+	throttle.set_adaptive (load, minimum, maximum);
+	if (throttle.get_effective_threshold () != minimum)
+	{
+		std::fprintf (stderr, "FAIL: effective threshold %g before any call, "
+			"not the minimum %g\n", throttle.get_effective_threshold (),
+			minimum);
+		++failures;
+	}
+
+	called.clear ();
+	for (unsigned int action = 0; action < ADAPTIVE_ACTIONS; ++action)
+		throttle.queue (sigc::bind (sigc::ptr_fun (&spend), cost), false);
+	run_until (sigc::ptr_fun (&calling));
+
+	if (called.size () != ADAPTIVE_ACTIONS)
+	{
+		std::fprintf (stderr, "FAIL: %zu of %u adaptive actions were called\n",
+			called.size (), ADAPTIVE_ACTIONS);
+		++failures;
+		return;
+	}
+
+	double effective = throttle.get_effective_threshold (),
+		expected = cost / load;
+	bool in_bounds = effective >= minimum && effective <= maximum, near;
+	if (expected <= minimum)
+		near = effective == minimum;
+	else if (expected >= maximum)
+		near = effective == maximum;
+	else
+		near = effective >= expected && effective <= 2.0 * expected;
+
+	if (!in_bounds || !near)
+	{
+		std::fprintf (stderr, "FAIL: effective threshold %g for a cost of %g "
+			"at a load of %g, within [%g, %g]; expected about %g\n",
+			effective, cost, load, minimum, maximum, expected);
+		++failures;
+	}
+
+	// Calls are spaced by at least the minimum, with a millisecond's slack
+	// for the difference between the clocks.
+	for (unsigned int action = 1; action < called.size (); ++action)
+	{
+		double interval = Seconds (called[action] - called[action - 1])
+			.count ();
+		if (interval < minimum - 0.001)
+		{
+			std::fprintf (stderr, "FAIL: adaptive actions called %g apart, "
+				"less than the minimum %g\n", interval, minimum);
+			++failures;
+			break;
+		}
+	}
+}
+
+//******************************************************************************
+
+
+int
+main ()
+{
+	Glib::init ();
+	loop = Glib::MainLoop::create ();
+
+	check_post ();
+
+	// Within the bounds, at the minimum and at the maximum
+	check_adaptive (0.01, 0.25, 0.005, 1.0);
+	check_adaptive (0.001, 0.5, 0.02, 1.0);
+	check_adaptive (0.02, 0.1, 0.0, 0.05);
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
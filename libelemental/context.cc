@@ -0,0 +1,323 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "private.hh"
+#include "strings.hh"
+#include <libelemental/context.hh>
+#include <libelemental/table.hh>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <libintl.h>
+
+namespace Elemental {
+
+
+static thread_local const Context *current = NULL;
+
+
+// The untranslated messages, indexed by string identifier. Written only by
+// assign_ids(), during initialization.
+static std::vector<const char*> msgids;
+
+// The generation of the global catalog, which is increased each time it is
+// reloaded. Written only by load_global(), under the mutex.
+static std::atomic<unsigned int> global_generation (0);
+static std::mutex reloading;
+
+
+//******************************************************************************
+// class Context
+
+
+const unsigned int Context::NO_ID;
+
+
+Context::Context (const std::string& locale)
+:	name (locale), global (false),
+	c_locale (newlocale (LC_ALL_MASK, locale.c_str (), (locale_t) 0))
+{
+	if (c_locale == (locale_t) 0)
+		throw std::runtime_error ("locale not available");
+
+	try
+	{
+		cxx_locale = std::locale (locale.c_str ());
+	}
+	catch (...)
+	{
+		freelocale (c_locale);
+		throw;
+	}
+
+	initialize ();
+	catalog.reset (load ());
+}
+
+
+Context::Context () throw ()
+:	global (true), c_locale ((locale_t) 0)
+{}
+
+
+Context::~Context ()
+{
+	if (c_locale != (locale_t) 0)
+		freelocale (c_locale);
+}
+
+
+const std::string&
+Context::get_name () const throw ()
+{
+	return name;
+}
+
+
+const std::locale&
+Context::get_locale () const throw ()
+{
+	return global ? get_global_pin ().locale : cxx_locale;
+}
+
+
+const char*
+Context::translate (const char* msgid) const throw ()
+{
+	if (global)
+		return g_dgettext (GETTEXT_PACKAGE, msgid);
+
+	// Messages not in the catalog, such as those of a later dataset, are
+	// looked up under the context's locale for this thread only. As always
+	// with gettext, the LANGUAGE environment variable takes precedence.
+	locale_t previous = uselocale (c_locale);
+	const char *result = dgettext (GETTEXT_PACKAGE, msgid);
+	uselocale (previous);
+	return result;
+}
+
+
+const char*
+Context::translate (unsigned int id, const char* msgid) const throw ()
+{
+	const Catalog *loaded = get_catalog ();
+	if (loaded != NULL && id < loaded->strings.size ())
+	{
+		Stats::count (Stats::CATALOG_HIT);
+		return loaded->strings[id];
+	}
+
+	Stats::count (Stats::CATALOG_MISS);
+	return translate (msgid);
+}
+
+
+Glib::ustring::size_type
+Context::get_max_name_length () const throw ()
+{
+	const Catalog *loaded = get_catalog ();
+	return (loaded != NULL) ? loaded->max_name_length : 0;
+}
+
+
+const Context&
+Context::get_global () throw ()
+{
+	return get_global_instance ();
+}
+
+
+void
+Context::reload_global () throw ()
+{
+	initialize ();
+	load_global ();
+}
+
+
+const Context&
+Context::get_current () throw ()
+{
+	return current ? *current : get_global_instance ();
+}
+
+
+Context&
+Context::get_global_instance () throw ()
+{
+	static Context global_context;
+	return global_context;
+}
+
+
+void
+Context::assign_ids (const std::vector<const Element*>& table) throw ()
+{
+	std::map<std::string, unsigned int> assigned;
+	msgids.assign (library_strings, library_strings + S_COUNT);
+
+	auto assign = [&assigned] (const ustring& msgid) -> unsigned int
+	{
+		if (msgid.empty ()) return NO_ID;
+
+		std::map<std::string, unsigned int>::iterator found =
+			assigned.find (msgid);
+		if (found != assigned.end ()) return found->second;
+
+		unsigned int id = msgids.size ();
+		msgids.push_back (msgid.data ());
+		assigned[msgid] = id;
+		return id;
+	};
+
+	FOREACH (std::list<Category*>, CATEGORIES, category)
+	{
+		(*category)->name.id = assign ((*category)->name.value);
+
+		FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+		{
+			(*prop)->name.id = assign ((*prop)->name.value);
+			(*prop)->format.id = assign ((*prop)->format.value);
+			(*prop)->description.id = assign ((*prop)->description.value);
+			FOREACH (std::list<const Message*>, (*prop)->sources, source)
+				(*source)->id = assign ((*source)->value);
+		}
+	}
+
+	CONST_FOREACH (std::vector<const Element*>, table, el)
+		FOREACH (std::list<Category*>, CATEGORIES, category)
+			FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+			{
+				const value_base *value;
+				try
+				{ value = &(*el)->get_property_base (**prop); }
+				catch (std::invalid_argument&)
+				{ continue; }
+
+				if cast (value, const Message, message)
+					message->id = assign (message->value);
+				else if cast (value, const Event, event)
+					event->where_id = assign (event->where);
+			}
+}
+
+
+Context::Catalog*
+Context::load () const throw ()
+{
+	Catalog *result = new Catalog;
+	result->strings.reserve (msgids.size ());
+	result->max_name_length = 0;
+	result->locale = global ? std::locale () : cxx_locale;
+	result->generation = 0;
+
+	if (global)
+		FOREACH (std::vector<const char*>, msgids, msgid)
+			result->strings.push_back (g_dgettext (GETTEXT_PACKAGE, *msgid));
+	else
+	{
+		locale_t previous = uselocale (c_locale);
+		FOREACH (std::vector<const char*>, msgids, msgid)
+			result->strings.push_back (dgettext (GETTEXT_PACKAGE, *msgid));
+		uselocale (previous);
+	}
+
+	const char *entry_name = result->strings[S_ENTRY_NAME];
+	FOREACH (std::list<Category*>, CATEGORIES, category)
+		FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+		{
+			unsigned int id = (*prop)->name.id;
+			ustring::size_type length = compose::ucompose (entry_name,
+				(id < result->strings.size ()) ? result->strings[id]
+					: (*prop)->name.value.data ()).size ();
+			if (length > result->max_name_length)
+				result->max_name_length = length;
+		}
+
+	return result;
+}
+
+
+const Context::Catalog*
+Context::get_catalog () const throw ()
+{
+	return global ? get_global_pin ().catalog.get () : catalog.get ();
+}
+
+
+// Loads a new global catalog in the current process locale.
+void
+Context::load_global () throw ()
+{
+	Context &global_context = get_global_instance ();
+	std::lock_guard<std::mutex> lock (reloading);
+
+	std::shared_ptr<const Catalog> current =
+		std::atomic_load (&global_context.catalog);
+
+	Catalog *loaded = global_context.load ();
+	loaded->generation = current ? current->generation + 1 : 0;
+	std::atomic_store (&global_context.catalog,
+		std::shared_ptr<const Catalog> (loaded));
+	global_generation.store (loaded->generation, std::memory_order_release);
+}
+
+
+// Each thread pins the global catalog it last used, and copies its C++ locale
+// so that get_locale() can return a reference which stays valid in the thread.
+// The pin is replaced only when the catalog has been reloaded, so that a lookup
+// costs one load of the generation; the replaced catalog is freed with its last
+// pin. Until the library has been initialized, there is no catalog, and
+// messages are looked up with gettext.
+const Context::Pin&
+Context::get_global_pin () throw ()
+{
+	static thread_local Pin pinned;
+
+	if (!pinned.catalog || pinned.catalog->generation !=
+		global_generation.load (std::memory_order_acquire))
+	{
+		pinned.catalog = std::atomic_load (&get_global_instance ().catalog);
+		pinned.locale = pinned.catalog ? pinned.catalog->locale : std::locale ();
+	}
+
+	return pinned;
+}
+
+
+//******************************************************************************
+// class Context::Scope
+
+
+Context::Scope::Scope (const Context& context) throw ()
+:	previous (current)
+{
+	current = &context;
+}
+
+
+Context::Scope::~Scope ()
+{
+	current = previous;
+}
+
+
+} // namespace Elemental
@@ -0,0 +1,179 @@
+//! \file context.hh
+//! Locale contexts for the rendering of values.
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBELEMENTAL__CONTEXT_HH
+#define LIBELEMENTAL__CONTEXT_HH
+
+#include <clocale>
+#include <locale>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glibmm/ustring.h>
+
+//******************************************************************************
+
+namespace Elemental {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class Element;
+#endif
+
+//! A locale in which values are rendered.
+/*! A context carries a C++ locale, used to format numbers, and a catalog of
+ * the library's translated messages, loaded when the context is constructed.
+ * The catalog covers every fixed string of the library and every message of
+ * the properties and the initial element data; a lookup in it is an index
+ * into an array.
+ * Contexts are immutable once constructed, so one context may be used from
+ * any number of threads at once, and contexts for different locales may be
+ * used at the same time without touching the process locale.
+ *
+ * Each thread has a current context, which is the global context unless a
+ * Context::Scope is active. Functions without a context parameter render
+ * their output in the current context. */
+class Context
+{
+public:
+
+	//! Constructs a new context for a named locale.
+	/*! The library is initialized if it has not been already.
+	 * \param locale The name of an installed locale, such as "fr_FR.UTF-8".
+	 * \throw std::runtime_error if the locale is not available. */
+	explicit Context (const std::string& locale);
+
+	~Context ();
+
+	//! Returns the name of the context's locale.
+	//! The global context's name is the empty string.
+	const std::string& get_name () const throw ();
+
+	//! Returns the C++ locale used to format numbers in this context.
+	const std::locale& get_locale () const throw ();
+
+	//! Returns the translation of a message in the library's domain.
+	/*! \param msgid An untranslated message.
+	 * \return The translated message, or \p msgid if it has no translation. */
+	const char* translate (const char* msgid) const throw ();
+
+	//! Returns the greatest length of a translated property name entry.
+	Glib::ustring::size_type get_max_name_length () const throw ();
+
+	//! Returns the global context.
+	/*! The global context renders in the process locale, as set with
+	 * setlocale() or, for a named locale, std::locale::global(), when the
+	 * library was initialized. A program which changes the process locale
+	 * afterwards must call reload_global() for the global context to follow
+	 * it. */
+	static const Context& get_global () throw ();
+
+	//! Reloads the global context's catalog and C++ locale in the current
+	//! process locale.
+	/*! Call this after changing the process locale, or when translations
+	 * change without a change of locale, as with the LANGUAGE environment
+	 * variable. Each thread rendering in the global context at the time goes
+	 * on with the catalog it was using until its next lookup; the replaced
+	 * catalog is freed once no thread uses it. */
+	static void reload_global () throw ();
+
+	//! Returns the calling thread's current context.
+	static const Context& get_current () throw ();
+
+	//! Makes a context current in the calling thread for its own lifetime.
+	/*! Scopes may be nested; the previously current context is restored when
+	 * a scope is destroyed. */
+	class Scope
+	{
+	public:
+
+		//! Makes a context current.
+		//! \param context The context to be made current.
+		explicit Scope (const Context& context) throw ();
+
+		~Scope ();
+
+	private:
+
+		Scope (const Scope&);
+		Scope& operator= (const Scope&);
+
+		const Context *previous;
+	};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	//! Returns the translation of a message with a string identifier.
+	//! For internal use.
+	const char* translate (unsigned int id, const char* msgid) const throw ();
+
+	//! The string identifier of messages not in the catalog.
+	//! For internal use.
+	static const unsigned int NO_ID = ~0u;
+#endif
+
+private:
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend void initialize () throw ();
+#endif
+
+	Context () throw ();
+
+	Context (const Context&);
+	Context& operator= (const Context&);
+
+	static Context& get_global_instance () throw ();
+
+	static void assign_ids (const std::vector<const Element*>& table)
+		throw ();
+
+	struct Catalog
+	{
+		std::vector<const char*> strings;
+		Glib::ustring::size_type max_name_length;
+		std::locale locale;
+		unsigned int generation;
+	};
+
+	struct Pin
+	{
+		std::shared_ptr<const Catalog> catalog;
+		std::locale locale;
+	};
+
+	Catalog* load () const throw ();
+	const Catalog* get_catalog () const throw ();
+
+	static void load_global () throw ();
+	static const Pin& get_global_pin () throw ();
+
+	std::string name;
+
+	bool global;
+	locale_t c_locale;
+	std::locale cxx_locale;
+
+	std::shared_ptr<const Catalog> catalog;
+};
+
+} // namespace Elemental
+
+#endif // LIBELEMENTAL__CONTEXT_HH
@@ -20,6 +20,7 @@
  */
 
 #include "private.hh"
+#include "strings.hh"
 #include <libelemental/element.hh>
 #include <libelemental/data.hh>
 #include <libelemental/table.hh>
@@ -29,13 +30,51 @@
 namespace Elemental {
 
 
+//******************************************************************************
+// class EntriesView
+
+
+void
+EntriesView::element_begin (const Element&) throw ()
+{}
+
+
+void
+EntriesView::element_end () throw ()
+{}
+
+
+void
+EntriesView::property_entry (const PropertyBase& property,
+	const value_base& value) throw ()
+{
+	// Notes are displayed as free text, without a name.
+	value.make_entry (*this, (&property == &P_NOTES) ? ustring ()
+		: compose::ucompose (translate (S_ENTRY_NAME), property.get_name ()),
+		property.get_format ());
+}
+
+
 //******************************************************************************
 // class PropertyBase
 
 
-PropertyBase::PropertyBase (const Message& name_, const Message& format_,
-	const Message& description_, const Message* sources_[]) throw ()
-:	name (name_), format (format_), description (description_)
+// Keys are given in the style of the property and category macros.
+static std::string
+make_key (const char* source) throw ()
+{
+	std::string result (source);
+	FOREACH (std::string, result, ch)
+		*ch = g_ascii_tolower (*ch);
+	return result;
+}
+
+
+PropertyBase::PropertyBase (const char* key_, const Message& name_,
+	const Message& format_, const Message& description_,
+	const Message* sources_[]) throw ()
+:	key (make_key (key_)), name (name_), format (format_),
+	description (description_)
 {
 	while (sources_ != NULL && *sources_ != NULL)
 		sources.push_back (*sources_++);
@@ -46,6 +85,13 @@ PropertyBase::~PropertyBase ()
 {}
 
 
+const std::string&
+PropertyBase::get_key () const throw ()
+{
+	return key;
+}
+
+
 ustring
 PropertyBase::get_name () const throw ()
 {
@@ -67,6 +113,23 @@ PropertyBase::get_format () const throw ()
 }
 
 
+std::string
+PropertyBase::get_unit () const throw ()
+{
+	if (!has_format ()) return std::string ();
+
+	std::string unmarked;
+	if (!append_unmarked (unmarked, format.value.raw ()))
+		return std::string ();
+
+	std::string::size_type reference = unmarked.find ("%1");
+	if (reference != std::string::npos)
+		unmarked.erase (reference, 2);
+
+	return misc::strstrip (unmarked);
+}
+
+
 ustring
 PropertyBase::get_description () const throw ()
 {
@@ -78,10 +141,7 @@ void
 PropertyBase::make_entry (EntriesView& view, const value_base& value) const
 	throw ()
 {
-	value.make_entry (view,
-		// Translators: This is the format for indicating the name of an entry.
-		compose::ucompose (_("%1:"), get_name ()),
-		get_format ());
+	view.property_entry (*this, value);
 }
 
 
@@ -93,6 +153,15 @@ PropertyBase::make_entry (EntriesView& view, const ustring& value) const
 }
 
 
+void
+PropertyBase::make_entry (const Context& context, EntriesView& view,
+	const value_base& value) const throw ()
+{
+	Context::Scope scope (context);
+	make_entry (view, value);
+}
+
+
 bool
 PropertyBase::is_colorable () const throw ()
 {
@@ -110,9 +179,11 @@ PropertyBase::is_colorable () const throw ()
 // class Property<Float>
 
 
-Property<Float>::Property (const Message& name_, const Message& format_,
-	const Message& description_, const Message* sources_[]) throw ()
-:	PropertyBase (name_, format_, description_, sources_), have_values (false)
+Property<Float>::Property (const char* key_, const Message& name_,
+	const Message& format_, const Message& description_,
+	const Message* sources_[]) throw ()
+:	PropertyBase (key_, name_, format_, description_, sources_),
+	scale_index (scale_count++)
 {}
 
 
@@ -123,55 +194,96 @@ Property<Float>::~Property ()
 bool
 Property<Float>::is_scale_valid () const throw ()
 {
-	return have_values && (minimum < maximum);
+	return get_scale ().is_valid ();
+}
+
+
+bool
+Property<Float>::is_scale_valid (const Dataset& dataset) const throw ()
+{
+	return get_scale (dataset).is_valid ();
 }
 
 
 double
 Property<Float>::get_scale_position (const Float& instance, bool logarithmic) const
 {
-	if (!is_scale_valid ()) throw std::domain_error ("invalid scale");
-	if (!instance.has_value ()) throw std::invalid_argument ("undefined value");
+	return get_scale ().get_position (instance, logarithmic);
+}
 
-	double value = logarithmic ? std::log10 (instance.value) : instance.value;
-	double min = logarithmic ? std::log10 (minimum) : minimum;
-	double max = logarithmic ? std::log10 (maximum) : maximum;
 
-	return (value - min) / (max - min);
+double
+Property<Float>::get_scale_position (const Dataset& dataset,
+	const Float& instance, bool logarithmic) const
+{
+	return get_scale (dataset).get_position (instance, logarithmic);
 }
 
 
 double
 Property<Float>::get_minimum () const
 {
-	if (!have_values) throw std::domain_error ("invalid scale");
-	return minimum;
+	return get_scale ().get_minimum ();
+}
+
+
+double
+Property<Float>::get_minimum (const Dataset& dataset) const
+{
+	return get_scale (dataset).get_minimum ();
 }
 
 
 double
 Property<Float>::get_medium (bool logarithmic) const
 {
-	if (!is_scale_valid ()) throw std::domain_error ("invalid scale");
-	
-	if (logarithmic)
-		return std::pow (10,
-			(std::log10 (maximum) + std::log10 (minimum)) / 2.0);
-	else
-		return (minimum + maximum) / 2.0;
+	return get_scale ().get_medium (logarithmic);
+}
+
+
+double
+Property<Float>::get_medium (const Dataset& dataset, bool logarithmic) const
+{
+	return get_scale (dataset).get_medium (logarithmic);
 }
 
 
 double
 Property<Float>::get_maximum () const
 {
-	if (!have_values) throw std::domain_error ("invalid scale");
-	return maximum;
+	return get_scale ().get_maximum ();
+}
+
+
+double
+Property<Float>::get_maximum (const Dataset& dataset) const
+{
+	return get_scale (dataset).get_maximum ();
+}
+
+
+bool
+Property<Float>::is_colorable () const throw ()
+{
+	return is_scale_valid ();
 }
 
 
+unsigned int
+Property<Float>::scale_count = 0;
+
+
+//******************************************************************************
+// struct Property<Float>::Scale
+
+
+Property<Float>::Scale::Scale () throw ()
+:	have_values (false), minimum (0.0), maximum (0.0)
+{}
+
+
 void
-Property<Float>::process_value (const Float& instance) throw ()
+Property<Float>::Scale::process_value (const Float& instance) throw ()
 {
 	if (!instance.has_value ()) return;
 	
@@ -191,9 +303,52 @@ Property<Float>::process_value (const Float& instance) throw ()
 
 
 bool
-Property<Float>::is_colorable () const throw ()
+Property<Float>::Scale::is_valid () const throw ()
 {
-	return is_scale_valid ();
+	return have_values && (minimum < maximum);
+}
+
+
+double
+Property<Float>::Scale::get_position (const Float& instance, bool logarithmic)
+	const
+{
+	if (!is_valid ()) throw std::domain_error ("invalid scale");
+	if (!instance.has_value ()) throw std::invalid_argument ("undefined value");
+
+	double value = logarithmic ? std::log10 (instance.value) : instance.value;
+	double min = logarithmic ? std::log10 (minimum) : minimum;
+	double max = logarithmic ? std::log10 (maximum) : maximum;
+
+	return (value - min) / (max - min);
+}
+
+
+double
+Property<Float>::Scale::get_minimum () const
+{
+	if (!have_values) throw std::domain_error ("invalid scale");
+	return minimum;
+}
+
+
+double
+Property<Float>::Scale::get_medium (bool logarithmic) const
+{
+	if (!is_valid ()) throw std::domain_error ("invalid scale");
+	
+	if (logarithmic)
+		return std::pow (10, (std::log10 (maximum) + std::log10 (minimum)) / 2.0);
+	else
+		return (minimum + maximum) / 2.0;
+}
+
+
+double
+Property<Float>::Scale::get_maximum () const
+{
+	if (!have_values) throw std::domain_error ("invalid scale");
+	return maximum;
 }
 
 
@@ -201,8 +356,9 @@ Property<Float>::is_colorable () const throw ()
 // class Category
 
 
-Category::Category (const Message& name_, PropertyBase* properties_[]) throw ()
-:	name (name_)
+Category::Category (const char* key_, const Message& name_,
+	PropertyBase* properties_[]) throw ()
+:	key (make_key (key_)), name (name_)
 {
 	while (properties_ != NULL && *properties_ != NULL)
 		properties.push_back (*properties_++);
@@ -213,6 +369,13 @@ Category::~Category ()
 {}
 
 
+const std::string&
+Category::get_key () const throw ()
+{
+	return key;
+}
+
+
 ustring
 Category::get_name () const throw ()
 {
@@ -242,19 +405,24 @@ Element::Element (const ElementData& data_) throw ()
 }
 
 
-const value_base&
-Element::get_property_base (const PropertyBase& property) const
+// Maps each stored property to its member of ElementData. Returns NULL for the
+// properties that Element derives from the stored ones.
+template<class Data, class Value>
+static Value*
+find_stored (Data& data, const PropertyBase& property)
 {
-#define retb(PROP, value) if (prop == &P_##PROP) return value;
-#define ret(PROP, member) retb (PROP, data.member)
+#define ret(PROP, member) if (prop == &P_##PROP) return &data.member;
 
 	const PropertyBase *prop = &property;
 
 	if (prop == &P_SYMBOL || prop == &P_NUMBER)
 		throw std::invalid_argument ("not a value property");
 
+	if (prop == &P_OFFICIAL_NAME || prop == &P_PHASE ||
+		prop == &P_LATTICE_VOLUME)
+		return NULL;
+
 	ret (NAME, name)
-	retb (OFFICIAL_NAME, official_name)
 	ret (ALTERNATE_NAME, alternate_name)
 	ret (SERIES, series)
 	ret (GROUP, group)
@@ -265,7 +433,6 @@ Element::get_property_base (const PropertyBase& property) const
 	ret (DISCOVERED_BY, discovered_by)
 	ret (ETYMOLOGY, etymology)
 
-	retb (PHASE, standard_phase)
 	ret (DENSITY_SOLID, density_solid)
 	ret (DENSITY_LIQUID, density_liquid)
 	ret (DENSITY_GAS, density_gas)
@@ -290,7 +457,6 @@ Element::get_property_base (const PropertyBase& property) const
 	ret (SPACE_GROUP, space_group)
 	ret (LATTICE_EDGES, lattice_edges)
 	ret (LATTICE_ANGLES, lattice_angles)
-	retb (LATTICE_VOLUME, lattice_volume)
 
 	ret (CONFIGURATION, configuration)
 	ret (OXIDATION_STATES, oxidation_states)
@@ -304,15 +470,66 @@ Element::get_property_base (const PropertyBase& property) const
 	throw std::invalid_argument ("unknown property");
 
 #undef ret
-#undef retb
+}
+
+
+const value_base*
+Element::get_stored (const ElementData& data, const PropertyBase& property)
+{
+	return find_stored<const ElementData, const value_base> (data, property);
+}
+
+
+value_base*
+Element::get_stored (ElementData& data, const PropertyBase& property)
+{
+	return find_stored<ElementData, value_base> (data, property);
+}
+
+
+const value_base&
+Element::get_property_base (const PropertyBase& property) const
+{
+	Stats::Timer timer (Stats::GET_PROPERTY_BASE);
+
+	const value_base *stored = get_stored (data, property);
+	if (stored != NULL)
+		return *stored;
+
+	const PropertyBase *prop = &property;
+	if (prop == &P_OFFICIAL_NAME) return official_name;
+	if (prop == &P_PHASE) return standard_phase;
+	return lattice_volume;
+}
+
+
+void
+Element::make_entry (EntriesView& view, const PropertyBase& property) const
+	throw ()
+{
+	if (&property == &P_SYMBOL)
+		P_SYMBOL.make_entry (view, symbol);
+	else if (&property == &P_NUMBER)
+		P_NUMBER.make_entry (view, Int (number));
+	else
+	{
+		try
+			{ property.make_entry (view, get_property_base (property)); }
+		catch (const std::invalid_argument &)
+			{}
+	}
 }
 
 
 void
 Element::make_entries (EntriesView& view) const throw ()
 {
+	Stats::Timer timer (Stats::MAKE_ENTRIES);
+
+	view.element_begin (*this);
 	FOREACH (std::list<Category*>, CATEGORIES, category)
 		make_entries (view, **category, true);
+	view.element_end ();
 }
 
 
@@ -320,9 +537,11 @@ void
 Element::make_entries (EntriesView& view, const Category& category, bool all)
 	const throw ()
 {
+	Stats::Timer timer (Stats::MAKE_CATEGORY_ENTRIES);
+
 	if (&category == &C_GENERAL)
 	{
-		view.header (compose::ucompose (_("%1 Properties"),
+		view.header (compose::ucompose (translate (S_PROPERTIES_HEADER),
 			data.name.get_string ()));
 		if (all)
 			P_NAME.make_entry (view, data.name);
@@ -333,7 +552,7 @@ Element::make_entries (EntriesView& view, const Category& category, bool all)
 		if (all)
 		{
 			P_SYMBOL.make_entry (view, symbol);
-			P_NUMBER.make_entry (view, compose::ucompose1 (number));
+			P_NUMBER.make_entry (view, Int (number));
 		}
 		P_SERIES.make_entry (view, data.series);
 		P_GROUP.make_entry (view, data.group);
@@ -345,7 +564,7 @@ Element::make_entries (EntriesView& view, const Category& category, bool all)
 		category.make_header (view);
 		P_COLOR.make_entry (view, data.color);
 		if (data.notes.has_value ())
-			data.notes.make_entry (view, ustring ());
+			P_NOTES.make_entry (view, data.notes);
 	}
 	else
 	{
@@ -356,6 +575,24 @@ Element::make_entries (EntriesView& view, const Category& category, bool all)
 }
 
 
+void
+Element::make_entries (const Context& context, EntriesView& view) const
+	throw ()
+{
+	Context::Scope scope (context);
+	make_entries (view);
+}
+
+
+void
+Element::make_entries (const Context& context, EntriesView& view,
+	const Category& category, bool all) const throw ()
+{
+	Context::Scope scope (context);
+	make_entries (view, category, all);
+}
+
+
 Phase
 Element::get_phase (double tempK) const throw ()
 {
@@ -429,4 +666,32 @@ Element::get_lattice_volume () const throw ()
 }
 
 
+//******************************************************************************
+
+
+const PropertyBase&
+get_property (const std::string& key)
+{
+	CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+		CONST_FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
+			if (g_ascii_strcasecmp ((*prop)->get_key ().c_str (),
+					key.c_str ()) == 0)
+				return **prop;
+
+	throw std::invalid_argument ("unknown property");
+}
+
+
+const Category&
+get_category (const std::string& key)
+{
+	CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+		if (g_ascii_strcasecmp ((*category)->get_key ().c_str (),
+				key.c_str ()) == 0)
+			return **category;
+
+	throw std::invalid_argument ("unknown category");
+}
+
+
 } // namespace Elemental
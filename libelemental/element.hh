@@ -37,6 +37,7 @@ namespace Elemental {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 struct ElementData; // defined in data.hh
+class Dataset; // defined in table.hh
 #endif
 
 //******************************************************************************
@@ -46,11 +47,15 @@ class PropertyBase
 {
 public:
 
-	PropertyBase (const Message& name, const Message& format,
+	PropertyBase (const char* key, const Message& name, const Message& format,
 		const Message& description, const Message* sources[]) throw ();
 
 	virtual ~PropertyBase ();
 
+	//! Returns an identifier for the property, such as "melting_point".
+	//! Keys are not translated and are suitable for machine-readable output.
+	const std::string& get_key () const throw ();
+
 	//! Returns the translated name of the property.
 	ustring get_name () const throw ();
 	
@@ -61,6 +66,12 @@ public:
 	//! If the format is undefined, returns the empty string.
 	ustring get_format () const throw ();
 
+	//! Returns the untranslated unit and conditions of values, if any.
+	/*! This is the format with its value reference and markup removed, such as
+	 * "K" or "g/cm3 at 20 deg. C". If the format is undefined, returns the
+	 * empty string. */
+	std::string get_unit () const throw ();
+
 	//! Returns a translated explanatory description of the property.
 	ustring get_description () const throw ();
 	
@@ -78,6 +89,13 @@ public:
 	/*! \param view The EntriesView to be populated.
 	 * \param value The value string to be added. */
 	void make_entry (EntriesView& view, const ustring& value) const throw ();
+
+	//! Possibly adds a value localized for a context to an EntriesView.
+	/*! \param context The Context in which to render the entry.
+	 * \param view The EntriesView to be populated.
+	 * \param value The value to be added. */
+	void make_entry (const Context& context, EntriesView& view,
+		const value_base& value) const throw ();
 	
 	//! Returns whether values of the property have color representations.
 	//! If \c true, values may or may not be color_value_base descendants.
@@ -85,6 +103,13 @@ public:
 
 protected:
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend class Context;
+#endif
+
+	//! The identifier of the property.
+	std::string key;
+
 	//! The untranslated name of the property.
 	Message name;
 
@@ -104,8 +129,9 @@ class Property
 {
 public:
 
-	inline Property (const Message& name, const Message& format,
-		const Message& description, const Message* sources[]) throw ();
+	inline Property (const char* key, const Message& name,
+		const Message& format, const Message& description,
+		const Message* sources[]) throw ();
 
 	virtual ~Property ();
 };
@@ -117,16 +143,23 @@ class Property<Float>
 {
 public:
 
-	Property (const Message& name, const Message& format,
-		const Message& description, const Message* sources[]) throw ();
+	Property (const char* key, const Message& name,
+		const Message& format, const Message& description,
+		const Message* sources[]) throw ();
 
 	virtual ~Property ();
 	
 	//! Returns whether the scale of values for this property is valid.
 	/*! The scale is valid if one or more elements has a defined value for this
-	 * property and those values are not all equal. */
+	 * property and those values are not all equal. The scale functions which
+	 * do not take a Dataset refer to the values in the current dataset, and
+	 * are subject to the same lifetime as get_table(). */
 	bool is_scale_valid () const throw ();
 
+	//! Returns whether the scale of values in a given dataset is valid.
+	//! \param dataset The dataset whose values make up the scale.
+	bool is_scale_valid (const Dataset& dataset) const throw ();
+
 	//! Returns the position on a normalized 0.0 to 1.0 scale for a value.
 	/*! \param instance A defined value for this property.
 	 * \param logarithmic Whether to compute the position on a logarithmic
@@ -135,32 +168,70 @@ public:
 	 * \throw std::invalid_argument if instance is not a defined value. */
 	double get_scale_position (const Float& instance, bool logarithmic = false) const;
 
+	//! Returns the position on the scale of a given dataset for a value.
+	/*! \param dataset The dataset whose values make up the scale.
+	 * For the other parameters and exceptions, see
+	 * get_scale_position(const Float&, bool). */
+	double get_scale_position (const Dataset& dataset, const Float& instance,
+		bool logarithmic = false) const;
+
 	//! Returns the least value of this property for any element.
 	//! \throw std::domain_error if the property does not have a valid scale.
 	double get_minimum () const;
 
+	//! Returns the least value of this property in a given dataset.
+	//! \throw std::domain_error if the property does not have a valid scale.
+	double get_minimum (const Dataset& dataset) const;
+
 	//! Returns the value of this property that has a scale position of 0.5.
 	/*! \param logarithmic Whether to compute the value on a logarithmic scale.
 	 * \throw std::domain_error if the property does not have a valid scale. */
 	double get_medium (bool logarithmic = false) const;
 
+	//! Returns the value that has a scale position of 0.5 in a given dataset.
+	/*! \param dataset The dataset whose values make up the scale.
+	 * \param logarithmic Whether to compute the value on a logarithmic scale.
+	 * \throw std::domain_error if the property does not have a valid scale. */
+	double get_medium (const Dataset& dataset, bool logarithmic = false) const;
+
 	//! Returns the greatest value of this property for any element.
 	//! \throw std::domain_error if the property does not have a valid scale.
 	double get_maximum () const;
 
+	//! Returns the greatest value of this property in a given dataset.
+	//! \throw std::domain_error if the property does not have a valid scale.
+	double get_maximum (const Dataset& dataset) const;
+
 	virtual bool is_colorable () const throw ();
 
 private:
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-	friend void initialize () throw ();
+	friend class Dataset;
 #endif
 
-	void process_value (const Float& instance) throw ();
+	struct Scale
+	{
+		Scale () throw ();
+		void process_value (const Float& instance) throw ();
+
+		bool is_valid () const throw ();
+		double get_position (const Float& instance, bool logarithmic) const;
+		double get_minimum () const;
+		double get_medium (bool logarithmic) const;
+		double get_maximum () const;
+
+		bool have_values;
+		double minimum;
+		double maximum;
+	};
 
-	bool have_values;
-	double minimum;
-	double maximum;
+	// Return the scale of this property in the current or a given dataset.
+	const Scale& get_scale () const throw ();
+	const Scale& get_scale (const Dataset& dataset) const throw ();
+
+	unsigned int scale_index;
+	static unsigned int scale_count;
 };
 
 //! A floating-point property of the chemical elements.
@@ -173,10 +244,14 @@ class Category
 {
 public:
 
-	Category (const Message& name, PropertyBase* properties[]) throw ();
+	Category (const char* key, const Message& name, PropertyBase* properties[])
+		throw ();
 
 	virtual ~Category ();
 
+	//! Returns an identifier for the category, such as "thermal".
+	const std::string& get_key () const throw ();
+
 	//! Returns the translated name of the category.
 	ustring get_name () const throw ();
 	
@@ -189,6 +264,13 @@ public:
 
 protected:
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend class Context;
+#endif
+
+	//! The identifier of the category.
+	std::string key;
+
 	//! The untranslated name of the category.
 	Message name;
 };
@@ -209,6 +291,13 @@ public:
 	//! \param property The Element Property to be returned.
 	template<class T> inline const T& get_property (const Property<T>& property) const;
 
+	//! Generates an entry for a single property.
+	/*! Unlike get_property_base(), this accepts \p P_SYMBOL and \p P_NUMBER.
+	 * \param view An EntriesView to be populated.
+	 * \param property The Property whose entry will be provided. */
+	void make_entry (EntriesView& view, const PropertyBase& property) const
+		throw ();
+
 	//! Generates entries for all properties.
 	//! \param view An EntriesView to be populated.
 	void make_entries (EntriesView& view) const throw ();
@@ -221,6 +310,20 @@ public:
 	void make_entries (EntriesView& view, const Category& category,
 		bool all = false) const throw ();
 
+	//! Generates entries for all properties, localized for a context.
+	/*! \param context The Context in which to render the entries.
+	 * \param view An EntriesView to be populated. */
+	void make_entries (const Context& context, EntriesView& view) const
+		throw ();
+
+	//! Generates entries for a Category's properties, localized for a context.
+	/*! \param context The Context in which to render the entries.
+	 * \param view An EntriesView to be populated.
+	 * \param category The Category whose properties will be provided.
+	 * \param all As for make_entries(EntriesView&, const Category&, bool). */
+	void make_entries (const Context& context, EntriesView& view,
+		const Category& category, bool all = false) const throw ();
+
 	//! Returns the phase of matter assumed by the element at a temperature.
 	/*! Standard pressure is implied.
 	 * \param tempK The temperature, in Kelvin, at which to determine phase. By
@@ -237,11 +340,19 @@ public:
 private:
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-	friend void initialize () throw ();
+	friend class Dataset;
+	friend class DatasetBuilder;
 #endif
 
 	Element (const ElementData& data) throw ();
 
+	// Return the member of data holding a property, or NULL if the property
+	// is derived. These throw std::invalid_argument as get_property_base().
+	static const value_base* get_stored (const ElementData& data,
+		const PropertyBase& property);
+	static value_base* get_stored (ElementData& data,
+		const PropertyBase& property);
+
 	const ElementData& data;
 	String official_name;
 	Phase standard_phase;
@@ -250,6 +361,20 @@ private:
 	Float get_lattice_volume () const throw ();
 };
 
+//******************************************************************************
+
+//! Returns the property with a given key.
+/*! Keys are compared without regard to ASCII case.
+ * \param key The key of the property, as returned by PropertyBase::get_key().
+ * \throw std::invalid_argument if no property has the key. */
+const PropertyBase& get_property (const std::string& key);
+
+//! Returns the category with a given key.
+/*! Keys are compared without regard to ASCII case.
+ * \param key The key of the category, as returned by Category::get_key().
+ * \throw std::invalid_argument if no category has the key. */
+const Category& get_category (const std::string& key);
+
 } // namespace Elemental
 
 // formerly part of this file; required by element.tcc
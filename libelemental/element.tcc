@@ -34,9 +34,10 @@ namespace Elemental {
 
 
 template<class T>
-Property<T>::Property (const Message& name_, const Message& format_,
-	const Message& description_, const Message* sources_[]) throw ()
-:	PropertyBase (name_, format_, description_, sources_)
+Property<T>::Property (const char* key_, const Message& name_,
+	const Message& format_, const Message& description_,
+	const Message* sources_[]) throw ()
+:	PropertyBase (key_, name_, format_, description_, sources_)
 {}
 
 
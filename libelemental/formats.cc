@@ -0,0 +1,602 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "private.hh"
+#include <libelemental/formats.hh>
+
+#include <charconv>
+#include <cmath>
+
+namespace Elemental {
+
+
+// A stream writer's buffer is written out once it reaches this size.
+static const std::string::size_type WRITER_BUFFER = 64 * 1024;
+
+
+static const char* const SERIES_CODES[] =
+{
+	"nonmetal", "noble_gas", "alkali_metal", "alkaline_earth_metal",
+	"semimetal", "halogen", "post_transition_metal", "transition_metal",
+	"lanthanide", "actinide"
+};
+
+static const char* const BLOCK_CODES[] = { "s", "p", "d", "f" };
+
+static const char* const PHASE_CODES[] = { "solid", "liquid", "gas" };
+
+static const char* const LATTICE_TYPE_CODES[] =
+{
+	"triclinic", "monoclinic", "orthorhombic", "tetragonal", "rhombohedral",
+	"hexagonal", "simple_cubic", "body_centered_cubic", "face_centered_cubic"
+};
+
+
+static void
+append_number (std::string& dest, double value) throw ()
+{
+	if (!std::isfinite (value))
+	{
+		dest += "null";
+		return;
+	}
+
+	char digits[32];
+	std::to_chars_result result =
+		std::to_chars (digits, digits + sizeof digits, value);
+	dest.append (digits, result.ptr);
+}
+
+
+static void
+append_number (std::string& dest, long value) throw ()
+{
+	char digits[24];
+	std::to_chars_result result =
+		std::to_chars (digits, digits + sizeof digits, value);
+	dest.append (digits, result.ptr);
+}
+
+
+template<class T>
+static void
+append_list (std::string& dest, const std::vector<T>& values) throw ()
+{
+	dest += '[';
+	for (typename std::vector<T>::const_iterator i = values.begin ();
+		i != values.end (); ++i)
+	{
+		if (i != values.begin ()) dest += ',';
+		append_number (dest, *i);
+	}
+	dest += ']';
+}
+
+
+// Appends text with any markup removed. Text with malformed markup is
+// appended unchanged.
+static void
+append_text (std::string& dest, const std::string& text) throw ()
+{
+	if (text.find_first_of ("<&") != std::string::npos)
+	{
+		std::string::size_type start = dest.size ();
+		if (append_unmarked (dest, text)) return;
+		dest.resize (start);
+	}
+	dest += text;
+}
+
+
+// Escapes the characters of dest from start onwards for a JSON string.
+static void
+escape_json (std::string& dest, std::string::size_type start) throw ()
+{
+	static const char HEX[] = "0123456789abcdef";
+
+	std::string::size_type first = start;
+	while (first < dest.size () && (unsigned char) dest[first] >= 0x20 &&
+		dest[first] != '"' && dest[first] != '\\')
+		++first;
+	if (first == dest.size ()) return;
+
+	std::string tail (dest, first);
+	dest.resize (first);
+	CONST_FOREACH (std::string, tail, ch)
+	{
+		unsigned char byte = *ch;
+		if (byte == '"' || byte == '\\')
+		{
+			dest += '\\';
+			dest += *ch;
+		}
+		else if (byte < 0x20)
+		{
+			dest += "\\u00";
+			dest += HEX[byte >> 4];
+			dest += HEX[byte & 0xF];
+		}
+		else
+			dest += *ch;
+	}
+}
+
+
+// Appends a string, quoted and escaped if json is true.
+static void
+append_string (std::string& dest, const std::string& text, bool json) throw ()
+{
+	if (!json)
+	{
+		append_text (dest, text);
+		return;
+	}
+
+	dest += '"';
+	std::string::size_type start = dest.size ();
+	append_text (dest, text);
+	escape_json (dest, start);
+	dest += '"';
+}
+
+
+// Appends a defined value in JSON syntax, or, if json is false, with strings
+// neither quoted nor escaped.
+static void
+append_value (std::string& dest, const value_base& value, bool json) throw ()
+{
+	if cast (&value, const Float, number)
+		append_number (dest, number->value);
+	else if cast (&value, const Int, number)
+		append_number (dest, number->value);
+	else if cast (&value, const FloatList, list)
+		append_list (dest, list->values);
+	else if cast (&value, const IntList, list)
+		append_list (dest, list->values);
+	else if cast (&value, const String, text)
+		append_string (dest, text->value.raw (), json);
+	else if cast (&value, const Message, message)
+		append_string (dest, message->value.raw (), json);
+	else if cast (&value, const Event, event)
+	{
+		dest += "{\"year\":";
+		append_number (dest, long (event->when));
+		dest += ",\"place\":";
+		append_string (dest, event->where.raw (), true);
+		dest += '}';
+	}
+	else if cast (&value, const Series, series)
+		append_string (dest, SERIES_CODES[series->value], json);
+	else if cast (&value, const Block, block)
+		append_string (dest, BLOCK_CODES[block->value], json);
+	else if cast (&value, const Phase, phase)
+		append_string (dest, PHASE_CODES[phase->value], json);
+	else if cast (&value, const LatticeType, lattice_type)
+		append_string (dest, LATTICE_TYPE_CODES[lattice_type->value], json);
+	else if cast (&value, const ColorValue, color_value)
+		append_string (dest, color_value->value.get_hex_spec (), json);
+	else
+		append_string (dest, value.get_string ().raw (), json);
+}
+
+
+//******************************************************************************
+// class EntriesWriter
+
+
+EntriesWriter::EntriesWriter (std::ostream& os_) throw ()
+:	out (buffer), os (&os_), in_record (false), finished (false)
+{
+	buffer.reserve (WRITER_BUFFER + 1024);
+}
+
+
+EntriesWriter::EntriesWriter (std::string& dest) throw ()
+:	out (dest), os (NULL), in_record (false), finished (false)
+{}
+
+
+EntriesWriter::~EntriesWriter ()
+{
+	flush ();
+}
+
+
+void
+EntriesWriter::element_begin (const Element& element) throw ()
+{
+	if (in_record) end_record ();
+	begin_record (&element);
+	in_record = true;
+}
+
+
+void
+EntriesWriter::element_end () throw ()
+{
+	if (in_record) end_record ();
+	in_record = false;
+
+	if (os != NULL && buffer.size () >= WRITER_BUFFER)
+		flush ();
+}
+
+
+void
+EntriesWriter::header (const ustring&) throw ()
+{}
+
+
+void
+EntriesWriter::entry (const ustring& name, const ustring& value,
+	const ustring&) throw ()
+{
+	Stats::Timer timer (Stats::WRITE_ENTRY);
+
+	ensure_record ();
+	write_field (name.raw (), NULL, value.raw (), std::string ());
+}
+
+
+void
+EntriesWriter::property_entry (const PropertyBase& property,
+	const value_base& value) throw ()
+{
+	Stats::Timer timer (Stats::WRITE_ENTRY);
+
+	ensure_record ();
+	write_field (property.get_key (), &value, std::string (),
+		property.get_unit ());
+}
+
+
+void
+EntriesWriter::empty_record () throw ()
+{
+	if (finished) return;
+	if (in_record) end_record ();
+	begin_record (NULL);
+	end_record ();
+	in_record = false;
+}
+
+
+void
+EntriesWriter::finish () throw ()
+{
+	if (finished) return;
+	if (in_record) end_record ();
+	in_record = false;
+	write_end ();
+	finished = true;
+}
+
+
+void
+EntriesWriter::flush () throw ()
+{
+	if (os == NULL) return;
+	os->write (buffer.data (), buffer.size ());
+	os->flush ();
+	buffer.clear ();
+}
+
+
+const char*
+EntriesWriter::get_qualifier_code (Qualifier qualifier) throw ()
+{
+	switch (qualifier)
+	{
+	case Q_UNK: return "unknown";
+	case Q_NA: return "not_applicable";
+	case Q_EST: return "estimated";
+	case Q_CA: return "approximate";
+	case Q_ISO: return "isotope";
+	case Q_NEUTRAL:
+	default:
+		return "";
+	}
+}
+
+
+void
+EntriesWriter::write_end () throw ()
+{}
+
+
+void
+EntriesWriter::append_json (std::string& dest, const value_base& value)
+	throw ()
+{
+	if (value.has_value ())
+		append_value (dest, value, true);
+	else
+		dest += "null";
+}
+
+
+void
+EntriesWriter::append_json (std::string& dest, const std::string& text)
+	throw ()
+{
+	append_string (dest, text, true);
+}
+
+
+void
+EntriesWriter::append_plain (std::string& dest, const value_base* value,
+	const std::string& text) throw ()
+{
+	if (value == NULL)
+		append_text (dest, text);
+	else if (value->has_value ())
+		append_value (dest, *value, false);
+}
+
+
+void
+EntriesWriter::ensure_record () throw ()
+{
+	if (in_record || finished) return;
+	begin_record (NULL);
+	in_record = true;
+}
+
+
+//******************************************************************************
+// class EntriesJSON
+
+
+EntriesJSON::EntriesJSON (std::ostream& os_) throw ()
+:	EntriesWriter (os_), lines (false), first_record (true), first_field (true)
+{}
+
+
+EntriesJSON::EntriesJSON (std::string& dest) throw ()
+:	EntriesWriter (dest), lines (false), first_record (true), first_field (true)
+{}
+
+
+EntriesJSON::EntriesJSON (std::ostream& os_, bool lines_) throw ()
+:	EntriesWriter (os_), lines (lines_), first_record (true), first_field (true)
+{}
+
+
+EntriesJSON::EntriesJSON (std::string& dest, bool lines_) throw ()
+:	EntriesWriter (dest), lines (lines_), first_record (true),
+	first_field (true)
+{}
+
+
+EntriesJSON::~EntriesJSON ()
+{}
+
+
+void
+EntriesJSON::begin_record (const Element*) throw ()
+{
+	if (!lines)
+		out += first_record ? "[\n" : ",\n";
+	out += '{';
+	first_record = false;
+	first_field = true;
+}
+
+
+void
+EntriesJSON::end_record () throw ()
+{
+	out += '}';
+	if (lines) out += '\n';
+}
+
+
+void
+EntriesJSON::write_field (const std::string& key, const value_base* value,
+	const std::string& text, const std::string& unit) throw ()
+{
+	if (!first_field) out += ',';
+	first_field = false;
+
+	append_json (out, key);
+	out += ":{\"value\":";
+
+	if (value != NULL)
+	{
+		append_json (out, *value);
+		if (!unit.empty ())
+		{
+			out += ",\"unit\":";
+			append_json (out, unit);
+		}
+		if (value->qualifier != Q_NEUTRAL)
+		{
+			out += ",\"qualifier\":\"";
+			out += get_qualifier_code (value->qualifier);
+			out += '"';
+		}
+	}
+	else
+		append_json (out, text);
+
+	out += '}';
+}
+
+
+void
+EntriesJSON::write_end () throw ()
+{
+	if (lines) return;
+	out += first_record ? "[]\n" : "\n]\n";
+}
+
+
+//******************************************************************************
+// class EntriesNDJSON
+
+
+EntriesNDJSON::EntriesNDJSON (std::ostream& os_) throw ()
+:	EntriesJSON (os_, true)
+{}
+
+
+EntriesNDJSON::EntriesNDJSON (std::string& dest) throw ()
+:	EntriesJSON (dest, true)
+{}
+
+
+EntriesNDJSON::~EntriesNDJSON ()
+{}
+
+
+//******************************************************************************
+// class EntriesCSV
+
+
+EntriesCSV::EntriesCSV (std::ostream& os_) throw ()
+:	EntriesWriter (os_)
+{
+	out += "number,symbol,property,value,unit,qualifier\n";
+}
+
+
+EntriesCSV::EntriesCSV (std::string& dest) throw ()
+:	EntriesWriter (dest)
+{
+	out += "number,symbol,property,value,unit,qualifier\n";
+}
+
+
+EntriesCSV::~EntriesCSV ()
+{}
+
+
+void
+EntriesCSV::begin_record (const Element* element) throw ()
+{
+	number.clear ();
+	symbol.clear ();
+
+	if (element != NULL)
+	{
+		append_number (number, long (element->number));
+		symbol = element->symbol;
+	}
+}
+
+
+void
+EntriesCSV::end_record () throw ()
+{}
+
+
+void
+EntriesCSV::write_field (const std::string& key, const value_base* value,
+	const std::string& text, const std::string& unit) throw ()
+{
+	out += number;
+	out += ',';
+	append_cell (symbol);
+	out += ',';
+	append_cell (key);
+	out += ',';
+
+	cell.clear ();
+	append_plain (cell, value, text);
+	append_cell (cell);
+	out += ',';
+
+	append_cell (unit);
+	out += ',';
+	if (value != NULL)
+		out += get_qualifier_code (value->qualifier);
+	out += '\n';
+}
+
+
+void
+EntriesCSV::append_cell (const std::string& text) throw ()
+{
+	if (text.find_first_of (",\"\n\r") == std::string::npos)
+	{
+		out += text;
+		return;
+	}
+
+	out += '"';
+	CONST_FOREACH (std::string, text, ch)
+	{
+		if (*ch == '"') out += '"';
+		out += *ch;
+	}
+	out += '"';
+}
+
+
+//******************************************************************************
+// class EntriesTSV
+
+
+EntriesTSV::EntriesTSV (std::ostream& os_) throw ()
+:	EntriesWriter (os_), first_field (true)
+{}
+
+
+EntriesTSV::EntriesTSV (std::string& dest) throw ()
+:	EntriesWriter (dest), first_field (true)
+{}
+
+
+EntriesTSV::~EntriesTSV ()
+{}
+
+
+void
+EntriesTSV::begin_record (const Element*) throw ()
+{
+	first_field = true;
+}
+
+
+void
+EntriesTSV::end_record () throw ()
+{
+	out += '\n';
+}
+
+
+void
+EntriesTSV::write_field (const std::string&, const value_base* value,
+	const std::string& text, const std::string&) throw ()
+{
+	if (!first_field) out += '\t';
+	first_field = false;
+
+	std::string::size_type start = out.size ();
+	append_plain (out, value, text);
+
+	// Fields may not contain the separators.
+	for (std::string::size_type i = start; i < out.size (); ++i)
+		if (out[i] == '\t' || out[i] == '\n' || out[i] == '\r')
+			out[i] = ' ';
+}
+
+
+} // namespace Elemental
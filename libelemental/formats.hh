@@ -0,0 +1,273 @@
+//! \file formats.hh
+//! Machine-readable views of value entries.
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBELEMENTAL__FORMATS_HH
+#define LIBELEMENTAL__FORMATS_HH
+
+#include <libelemental/value.hh>
+#include <libelemental/element.hh>
+
+#include <ostream>
+#include <string>
+
+//******************************************************************************
+
+namespace Elemental {
+
+//! A base class for views which write machine-readable records.
+/*! Each element passed to Element::make_entries() becomes one record, and each
+ * property one field of it. Fields hold typed values: numbers are written in
+ * full precision without localization or decoration, enumerated values as
+ * fixed codes, and messages untranslated and without markup. Each field also
+ * carries the property's unit, from PropertyBase::get_unit(), and a code for
+ * its Qualifier. Category headers are not written.
+ *
+ * Output is written into a buffer. For a stream, the buffer is written out
+ * when it fills, when flush() is called, and when the writer is destroyed; for
+ * a string, the buffer is the string itself. The owner must call finish()
+ * after the last record, before destroying the writer. */
+class EntriesWriter
+:	public EntriesView
+{
+public:
+
+	//! Destroys the writer, writing out any buffered output.
+	/*! The closing syntax is only written by finish(), which must have been
+	 * called first for the output to be complete. */
+	virtual ~EntriesWriter ();
+
+	virtual void element_begin (const Element& element) throw ();
+
+	virtual void element_end () throw ();
+
+	//! Ignored; writers do not group fields by category.
+	virtual void header (const ustring& category) throw ();
+
+	//! Writes a field with a string value, named by \p name.
+	virtual void entry (const ustring& name, const ustring& value,
+		const ustring& tip = ustring ()) throw ();
+
+	virtual void property_entry (const PropertyBase& property,
+		const value_base& value) throw ();
+
+	//! Writes a record with no fields.
+	//! Any current record is ended first.
+	void empty_record () throw ();
+
+	//! Writes any closing syntax of the output.
+	/*! No records may be written afterwards. The owner of the writer must
+	 * call this once all records have been written; the destructor does not,
+	 * since the derived writer is already gone by then. */
+	void finish () throw ();
+
+	//! For a stream, writes any buffered output and flushes the stream.
+	void flush () throw ();
+
+	//! Returns the code written for a qualifier.
+	//! The code for \p Q_NEUTRAL is the empty string; it is not written.
+	static const char* get_qualifier_code (Qualifier qualifier) throw ();
+
+protected:
+
+	//! Constructs a new writer for an output stream.
+	explicit EntriesWriter (std::ostream& os) throw ();
+
+	//! Constructs a new writer which appends to a string.
+	explicit EntriesWriter (std::string& dest) throw ();
+
+	//! Begins a record. The element is NULL for entries outside a record.
+	virtual void begin_record (const Element* element) throw () = 0;
+
+	//! Ends the current record.
+	virtual void end_record () throw () = 0;
+
+	//! Writes a field of the current record.
+	/*! \param key The key of the field.
+	 * \param value The value, or NULL for a string value.
+	 * \param text The string value if \p value is NULL.
+	 * \param unit The unit of the value, if any. */
+	virtual void write_field (const std::string& key, const value_base* value,
+		const std::string& text, const std::string& unit) throw () = 0;
+
+	//! Writes any closing syntax of the output.
+	virtual void write_end () throw ();
+
+	//! Appends a value in JSON syntax.
+	/*! Undefined values are \c null; lists are arrays; events are objects with
+	 * "year" and "place" members. */
+	static void append_json (std::string& dest, const value_base& value)
+		throw ();
+
+	//! Appends a string in JSON syntax, with any markup removed.
+	static void append_json (std::string& dest, const std::string& text)
+		throw ();
+
+	//! Appends a value as plain text.
+	/*! The text is as written by append_json(), but strings are not quoted or
+	 * escaped, and undefined values are empty.
+	 * \param dest The string to which the text is appended.
+	 * \param value The value, or NULL for a string value.
+	 * \param text The string value if \p value is NULL. */
+	static void append_plain (std::string& dest, const value_base* value,
+		const std::string& text) throw ();
+
+	//! The buffer into which output is written.
+	std::string &out;
+
+private:
+
+	void ensure_record () throw ();
+
+	std::string buffer;
+	std::ostream *os;
+
+	bool in_record;
+	bool finished;
+};
+
+//******************************************************************************
+
+//! A view which writes a JSON array of objects, one per record.
+/*! Each object maps property keys to field objects with "value" and, where
+ * applicable, "unit" and "qualifier" members. */
+class EntriesJSON
+:	public EntriesWriter
+{
+public:
+
+	//! Constructs a new EntriesJSON for an output stream.
+	explicit EntriesJSON (std::ostream& os) throw ();
+
+	//! Constructs a new EntriesJSON which appends to a string.
+	explicit EntriesJSON (std::string& dest) throw ();
+
+	virtual ~EntriesJSON ();
+
+protected:
+
+	//! Constructs a new EntriesJSON, possibly writing one object per line.
+	EntriesJSON (std::ostream& os, bool lines) throw ();
+
+	//! Constructs a new EntriesJSON, possibly writing one object per line.
+	EntriesJSON (std::string& dest, bool lines) throw ();
+
+	virtual void begin_record (const Element* element) throw ();
+	virtual void end_record () throw ();
+	virtual void write_field (const std::string& key, const value_base* value,
+		const std::string& text, const std::string& unit) throw ();
+	virtual void write_end () throw ();
+
+private:
+
+	bool lines;
+	bool first_record;
+	bool first_field;
+};
+
+//******************************************************************************
+
+//! A view which writes newline-delimited JSON, one object per line.
+//! The objects are as written by EntriesJSON.
+class EntriesNDJSON
+:	public EntriesJSON
+{
+public:
+
+	//! Constructs a new EntriesNDJSON for an output stream.
+	explicit EntriesNDJSON (std::ostream& os) throw ();
+
+	//! Constructs a new EntriesNDJSON which appends to a string.
+	explicit EntriesNDJSON (std::string& dest) throw ();
+
+	virtual ~EntriesNDJSON ();
+};
+
+//******************************************************************************
+
+//! A view which writes comma-separated values, one row per field.
+/*! The columns are "number", "symbol", "property", "value", "unit", and
+ * "qualifier". Scalar values are written as in JSON, without quotes; lists and
+ * events are written as JSON text. */
+class EntriesCSV
+:	public EntriesWriter
+{
+public:
+
+	//! Constructs a new EntriesCSV for an output stream.
+	explicit EntriesCSV (std::ostream& os) throw ();
+
+	//! Constructs a new EntriesCSV which appends to a string.
+	explicit EntriesCSV (std::string& dest) throw ();
+
+	virtual ~EntriesCSV ();
+
+protected:
+
+	virtual void begin_record (const Element* element) throw ();
+	virtual void end_record () throw ();
+	virtual void write_field (const std::string& key, const value_base* value,
+		const std::string& text, const std::string& unit) throw ();
+
+private:
+
+	void append_cell (const std::string& cell) throw ();
+
+	std::string number;
+	std::string symbol;
+	std::string cell;
+};
+
+//******************************************************************************
+
+//! A view which writes tab-separated values, one row per record.
+/*! Values are written as by EntriesCSV, without units or qualifiers, in the
+ * order of their entries. Tabs and line breaks within values are replaced with
+ * spaces. No header row is written, so a record with no fields is an empty
+ * line. */
+class EntriesTSV
+:	public EntriesWriter
+{
+public:
+
+	//! Constructs a new EntriesTSV for an output stream.
+	explicit EntriesTSV (std::ostream& os) throw ();
+
+	//! Constructs a new EntriesTSV which appends to a string.
+	explicit EntriesTSV (std::string& dest) throw ();
+
+	virtual ~EntriesTSV ();
+
+protected:
+
+	virtual void begin_record (const Element* element) throw ();
+	virtual void end_record () throw ();
+	virtual void write_field (const std::string& key, const value_base* value,
+		const std::string& text, const std::string& unit) throw ();
+
+private:
+
+	bool first_field;
+};
+
+} // namespace Elemental
+
+#endif // LIBELEMENTAL__FORMATS_HH
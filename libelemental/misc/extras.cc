@@ -115,16 +115,217 @@ ustrsplit (const ustring& data, const ustring& delimiter,
 string
 strstrip (const string& string)
 {
-	return Glib::ScopedPtr<gchar>
-		(g_strstrip (g_strdup (string.data ()))).get ();
+	return std::string (strstrip_view (string));
 }
 
 
 ustring
 ustrstrip (const ustring& string)
 {
-	return Glib::ScopedPtr<gchar>
-		(g_strstrip (g_strdup (string.data ()))).get ();
+	return std::string (strstrip_view (string.raw ()));
+}
+
+
+//******************************************************************************
+// class SplitView
+
+
+SplitView::SplitView (std::string_view data_, std::string_view delimiter_,
+	unsigned int max_tokens_, bool utf8_) throw ()
+:	data (data_), delimiter (delimiter_), max_tokens (max_tokens_),
+	utf8 (false)
+{
+	// A delimiter of ASCII characters can be searched for bytewise, even in
+	// UTF-8, since such bytes never occur within a multibyte character.
+	if (utf8_)
+		for (std::string_view::const_iterator i = delimiter.begin ();
+			i != delimiter.end (); ++i)
+			if (static_cast<unsigned char> (*i) >= 0x80)
+				{ utf8 = true; break; }
+}
+
+
+std::string_view::size_type
+SplitView::find_delimiter (std::string_view::size_type pos,
+	std::string_view::size_type& length) const throw ()
+{
+	if (!utf8)
+	{
+		length = 1;
+		return data.find_first_of (delimiter, pos);
+	}
+
+	while (pos < data.size ())
+	{
+		std::string_view::size_type char_length =
+			g_utf8_skip[static_cast<unsigned char> (data[pos])];
+
+		for (std::string_view::size_type i = 0; i < delimiter.size ();
+			i += length)
+		{
+			length = g_utf8_skip[static_cast<unsigned char> (delimiter[i])];
+			if (length == char_length &&
+				data.compare (pos, length, delimiter, i, length) == 0)
+				return pos;
+		}
+
+		pos += char_length;
+	}
+
+	return std::string_view::npos;
+}
+
+
+//******************************************************************************
+// class SplitView::const_iterator
+
+
+SplitView::const_iterator::const_iterator () throw ()
+:	view (NULL), next (std::string_view::npos), tokens (0)
+{}
+
+
+SplitView::const_iterator::const_iterator (const SplitView& view_) throw ()
+:	view (&view_), next (0), tokens (0)
+{
+	if (view->data.empty ())
+	{
+		// As with strsplit(), an empty string has no pieces.
+		view = NULL;
+		next = std::string_view::npos;
+	}
+	else
+		find_piece ();
+}
+
+
+SplitView::const_iterator&
+SplitView::const_iterator::operator++ () throw ()
+{
+	if (next == std::string_view::npos)
+	{
+		view = NULL;
+		piece = std::string_view ();
+	}
+	else
+		find_piece ();
+	return *this;
+}
+
+
+SplitView::const_iterator
+SplitView::const_iterator::operator++ (int) throw ()
+{
+	const_iterator result (*this);
+	++*this;
+	return result;
+}
+
+
+bool
+SplitView::const_iterator::operator== (const const_iterator& other) const
+	throw ()
+{
+	return view == other.view && piece.data () == other.piece.data () &&
+		next == other.next;
+}
+
+
+void
+SplitView::const_iterator::find_piece () throw ()
+{
+	std::string_view::size_type found = std::string_view::npos, length = 0;
+	if (view->max_tokens == 0 || tokens + 1 < view->max_tokens)
+		found = view->find_delimiter (next, length);
+
+	if (found == std::string_view::npos)
+	{
+		// The last piece is the remainder of the string.
+		piece = view->data.substr (next);
+		next = std::string_view::npos;
+	}
+	else
+	{
+		piece = view->data.substr (next, found - next);
+		next = found + length;
+	}
+
+	++tokens;
+}
+
+
+//******************************************************************************
+
+
+SplitView
+split_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens) throw ()
+{
+	return SplitView (data, delimiter, max_tokens, false);
+}
+
+
+SplitView
+usplit_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens) throw ()
+{
+	return SplitView (data, delimiter, max_tokens, true);
+}
+
+
+std::vector<std::string_view>
+strsplit_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens)
+{
+	SplitView view (data, delimiter, max_tokens, false);
+	return std::vector<std::string_view> (view.begin (), view.end ());
+}
+
+
+std::vector<std::string_view>
+ustrsplit_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens)
+{
+	SplitView view (data, delimiter, max_tokens, true);
+	return std::vector<std::string_view> (view.begin (), view.end ());
+}
+
+
+std::string_view
+strstrip_view (std::string_view data) throw ()
+{
+	while (!data.empty () && g_ascii_isspace (data.front ()))
+		data.remove_prefix (1);
+	while (!data.empty () && g_ascii_isspace (data.back ()))
+		data.remove_suffix (1);
+	return data;
+}
+
+
+std::string_view
+ustrstrip_view (std::string_view data) throw ()
+{
+	while (!data.empty ())
+	{
+		gunichar ch = g_utf8_get_char_validated (data.data (),
+			data.size ());
+		if (ch >= 0x110000 || !g_unichar_isspace (ch)) break;
+		data.remove_prefix (g_utf8_skip[static_cast<unsigned char>
+			(data.front ())]);
+	}
+
+	while (!data.empty ())
+	{
+		const char *end = data.data () + data.size (),
+			*last = g_utf8_find_prev_char (data.data (), end);
+		if (last == NULL) last = data.data ();
+
+		gunichar ch = g_utf8_get_char_validated (last, end - last);
+		if (ch >= 0x110000 || !g_unichar_isspace (ch)) break;
+		data.remove_suffix (end - last);
+	}
+
+	return data;
 }
 
 
@@ -23,8 +23,11 @@
 #define LIBMISC__EXTRAS_HH
 
 #include <ctime>
+#include <iterator>
+#include <locale>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <glibmm/ustring.h>
 
@@ -65,6 +68,16 @@ ucompose1 (const T &src, int precision = 0)
 	os << src; return os.str ();
 }
 
+//! Compose a single object into its UTF-8 string representation in a locale.
+template<typename T>
+inline ustring
+ucompose1 (const T &src, int precision, const std::locale &loc)
+{
+	std::ostringstream os; os.imbue (loc);
+	if (precision > 0) os.precision (precision);
+	os << src; return os.str ();
+}
+
 } // namespace compose
 
 //******************************************************************************
@@ -118,6 +131,116 @@ string strstrip (const string& string);
 //! Removes leading and trailing whitespace from a UTF-8 string.
 ustring ustrstrip (const ustring& string);
 
+//******************************************************************************
+
+//! A string split lazily into pieces using a delimiter.
+/*! The pieces are views into the split string, which must outlive them, and
+ * are found only as they are iterated over. The pieces are those that
+ * strsplit() or ustrsplit() would return.
+ * \sa split_view(), usplit_view() */
+class SplitView
+{
+public:
+
+	//! An iterator over the pieces of a split string.
+	class const_iterator
+	{
+	public:
+
+		typedef std::forward_iterator_tag iterator_category;
+		typedef std::string_view value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const std::string_view* pointer;
+		typedef const std::string_view& reference;
+
+		//! Constructs a past-the-end iterator.
+		const_iterator () throw ();
+
+		reference operator* () const throw () { return piece; }
+		pointer operator-> () const throw () { return &piece; }
+
+		//! Advances to the next piece.
+		const_iterator& operator++ () throw ();
+
+		//! Advances to the next piece.
+		const_iterator operator++ (int) throw ();
+
+		bool operator== (const const_iterator& other) const throw ();
+		bool operator!= (const const_iterator& other) const throw ()
+			{ return !(*this == other); }
+
+	private:
+
+		friend class SplitView;
+
+		explicit const_iterator (const SplitView& view) throw ();
+
+		void find_piece () throw ();
+
+		const SplitView *view;
+		std::string_view piece;
+		std::string_view::size_type next;
+		unsigned int tokens;
+	};
+
+	//! Splits a string.
+	/*! \param data A string to split.
+	 * \param delimiter A string of the characters at which to split \p data.
+	 * \param max_tokens The maximum number of pieces to split \p data into,
+	 * or zero to split it completely.
+	 * \param utf8 Whether \p delimiter is a UTF-8 string of characters, rather
+	 * than of bytes. */
+	SplitView (std::string_view data, std::string_view delimiter,
+		unsigned int max_tokens = 0, bool utf8 = false) throw ();
+
+	//! Returns an iterator at the first piece.
+	const_iterator begin () const throw () { return const_iterator (*this); }
+
+	//! Returns a past-the-end iterator.
+	const_iterator end () const throw () { return const_iterator (); }
+
+private:
+
+	std::string_view::size_type find_delimiter (std::string_view::size_type pos,
+		std::string_view::size_type& length) const throw ();
+
+	std::string_view data;
+	std::string_view delimiter;
+	unsigned int max_tokens;
+	bool utf8;
+};
+
+//! Splits a string lazily into pieces using a delimiter.
+/*! The arguments are those of strsplit().
+ * \return A view over the pieces, which are views into \p data. */
+SplitView split_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens = 0) throw ();
+
+//! Splits a UTF-8 string lazily into pieces using a delimiter.
+/*! The arguments are those of ustrsplit().
+ * \return A view over the pieces, which are views into \p data. */
+SplitView usplit_view (std::string_view data, std::string_view delimiter,
+	unsigned int max_tokens = 0) throw ();
+
+//! Splits a string into pieces using a delimiter, without copying them.
+/*! The arguments are those of strsplit().
+ * \return A vector of views into \p data. */
+std::vector<std::string_view> strsplit_view (std::string_view data,
+	std::string_view delimiter, unsigned int max_tokens = 0);
+
+//! Splits a UTF-8 string into pieces using a delimiter, without copying them.
+/*! The arguments are those of ustrsplit().
+ * \return A vector of views into \p data. */
+std::vector<std::string_view> ustrsplit_view (std::string_view data,
+	std::string_view delimiter, unsigned int max_tokens = 0);
+
+//! Returns a view of a string without its leading and trailing ASCII whitespace.
+std::string_view strstrip_view (std::string_view data) throw ();
+
+//! Returns a view of a UTF-8 string without its leading and trailing whitespace.
+/*! Any Unicode whitespace character is stripped, not only ASCII whitespace. */
+std::string_view ustrstrip_view (std::string_view data) throw ();
+
 } // namespace misc
 
 #endif // LIBMISC__EXTRAS_HH
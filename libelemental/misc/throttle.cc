@@ -19,19 +19,53 @@
 
 #include "throttle.hh"
 
-#include <sigc++/adaptors/bind.h>
-#include <glibmm/main.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <sigc++/functors/mem_fun.h>
+#include <sigc++/functors/ptr_fun.h>
+#include <glibmm/dispatcher.h>
 
 namespace misc {
 
 
+// The ADAPTIVE mode's default load.
+static const double DEFAULT_LOAD = 0.25;
+
+// The weight of each action's cost in the ADAPTIVE mode's moving average.
+static const double COST_WEIGHT = 0.25;
+
+// The throttles with posted actions not yet queued, in the order they were
+// first posted to, and the dispatcher which drains them. The dispatcher is
+// created by the first throttle, in the main loop's thread, and is never
+// destroyed.
+static std::mutex posting;
+static std::list<Throttle*> posting_throttles;
+static Glib::Dispatcher *posting_dispatcher = NULL;
+
+
 //******************************************************************************
 // class Throttle
 
 
 Throttle::Throttle (Mode mode_, double threshold_, bool immediate)
-:	mode (OPEN), threshold (0.0), running (false)
+:	mode (OPEN), threshold (0.0), load (DEFAULT_LOAD), minimum (0.0),
+	cost (0.0), running (false),
+	update_timer (sigc::mem_fun (*this, &Throttle::on_update_timer)),
+	posted_head (NULL), stats (),
+	log_timer (sigc::mem_fun (*this, &Throttle::on_log_timer)),
+	log_interval (0)
 {
+	{
+		std::lock_guard<std::mutex> lock (posting);
+		if (posting_dispatcher == NULL)
+		{
+			posting_dispatcher = new Glib::Dispatcher ();
+			posting_dispatcher->connect (sigc::ptr_fun (&Throttle::on_dispatch));
+		}
+	}
+
 	set (mode_, threshold_, immediate);
 }
 
@@ -39,6 +73,19 @@ Throttle::Throttle (Mode mode_, double threshold_, bool immediate)
 Throttle::~Throttle ()
 {
 	cancel_update ();
+
+	{
+		std::lock_guard<std::mutex> lock (posting);
+		posting_throttles.remove (this);
+	}
+
+	Posted *posted = posted_head.exchange (NULL, std::memory_order_acquire);
+	while (posted != NULL)
+	{
+		Posted *next = posted->next;
+		delete posted;
+		posted = next;
+	}
 }
 
 
@@ -80,6 +127,37 @@ Throttle::reset (bool immediate) throw ()
 }
 
 
+void
+Throttle::set_adaptive (double load_, double minimum_, double maximum)
+{
+	if (!(load_ > 0.0 && load_ <= 1.0))
+		throw std::invalid_argument ("invalid load");
+	if (minimum_ < 0.0 || maximum < minimum_)
+		throw std::invalid_argument ("invalid bounds");
+
+	do_set (ADAPTIVE, false);
+	load = load_;
+	minimum = minimum_;
+	set_threshold (maximum);
+}
+
+
+double
+Throttle::get_load () const throw ()
+{
+	return load;
+}
+
+
+double
+Throttle::get_effective_threshold () const throw ()
+{
+	if (mode != ADAPTIVE)
+		return threshold;
+	return std::min (std::max (cost / load, minimum), threshold);
+}
+
+
 double
 Throttle::get_threshold () const throw ()
 {
@@ -100,9 +178,44 @@ Throttle::set_threshold (double threshold_)
 void
 Throttle::queue (const Action& action, bool idempotent) throw ()
 {
-	if (idempotent) clear ();
-	action_queue.push (action);
-	update (true);
+	Entry entry = { action, NULL, false, g_get_monotonic_time () };
+	enqueue (entry, idempotent);
+}
+
+
+void
+Throttle::queue (const Action& action, Key key) throw ()
+{
+	Entry entry = { action, key, true, g_get_monotonic_time () };
+	enqueue (entry, false);
+}
+
+
+void
+Throttle::post (const Action& action, bool idempotent) throw ()
+{
+	Posted *posted = new (std::nothrow) Posted;
+	if (posted == NULL) return;
+	posted->entry.action = action;
+	posted->entry.key = NULL;
+	posted->entry.keyed = false;
+	posted->entry.queued_at = g_get_monotonic_time ();
+	posted->idempotent = idempotent;
+	push_posted (posted);
+}
+
+
+void
+Throttle::post (const Action& action, Key key) throw ()
+{
+	Posted *posted = new (std::nothrow) Posted;
+	if (posted == NULL) return;
+	posted->entry.action = action;
+	posted->entry.key = key;
+	posted->entry.keyed = true;
+	posted->entry.queued_at = g_get_monotonic_time ();
+	posted->idempotent = false;
+	push_posted (posted);
 }
 
 
@@ -113,11 +226,43 @@ Throttle::empty () const throw ()
 }
 
 
+Throttle::Stats
+Throttle::get_stats () const throw ()
+{
+	Stats result = stats;
+	result.depth = action_queue.size ();
+	return result;
+}
+
+
+void
+Throttle::reset_stats () throw ()
+{
+	stats = Stats ();
+}
+
+
+void
+Throttle::set_stats_log (const std::string& name, double interval)
+{
+	if (interval < 0.0)
+		throw std::invalid_argument ("negative interval");
+
+	log_name = name;
+	log_interval = (unsigned int) (interval * 1000.0);
+	if (log_interval > 0)
+		log_timer.arm (log_interval);
+	else
+		log_timer.cancel ();
+}
+
+
 void
 Throttle::clear () throw ()
 {
-	while (!action_queue.empty ())
-		action_queue.pop ();
+	stats.dropped += action_queue.size ();
+	action_queue.clear ();
+	keyed_actions.clear ();
 }
 
 
@@ -130,6 +275,7 @@ Throttle::do_set (Mode mode_, bool immediate)
 	case CLOSED:
 	case LIMIT:
 	case DELAY:
+	case ADAPTIVE:
 		stop ();
 		break;
 	case PAUSE:
@@ -212,6 +358,15 @@ Throttle::update (bool from_queue) throw ()
 		else if (!running || from_queue)
 			start ();
 		break;
+	case ADAPTIVE:
+		if ((!running || timer.elapsed () >= get_effective_threshold ()) &&
+			!action_queue.empty ())
+		{
+			start ();
+			run_top ();
+			measure (timer.elapsed ());
+		}
+		break;
 	default:
 		return false;
 	}
@@ -226,56 +381,205 @@ Throttle::update (bool from_queue) throw ()
 }
 
 
+void
+Throttle::measure (double elapsed) throw ()
+{
+	if (cost == 0.0)
+		cost = elapsed;
+	else
+		cost += (elapsed - cost) * COST_WEIGHT;
+}
+
+
+void
+Throttle::on_update_timer () throw ()
+{
+	update ();
+}
+
+
 void
 Throttle::request_update (unsigned int interval) throw ()
 {
 	if (interval == 0)
 	{
-		double until = threshold - timer.elapsed ();
+		double until = get_effective_threshold () - timer.elapsed ();
 		interval = (until > 0.0) ? (unsigned int) (until * 1000.0) : 0u;
 	}
-	if (!update_conn)
-		update_conn = Glib::signal_timeout ().connect (sigc::bind
-			(sigc::mem_fun (*this, &Throttle::update), false), ++interval);
+	if (!update_timer.is_armed ())
+		update_timer.arm (++interval);
 }
 
 
 void
 Throttle::cancel_update () throw ()
 {
-	if (update_conn)
-		update_conn.disconnect ();
-	update_conn = sigc::connection ();
+	update_timer.cancel ();
 }
 
 
 void
-Throttle::run_top () throw ()
+Throttle::push_posted (Posted *posted) throw ()
 {
-	if (!action_queue.empty ())
+	// Once pushed, the node belongs to the main loop's thread.
+	Posted *previous = posted_head.load (std::memory_order_relaxed);
+	do
+		posted->next = previous;
+	while (!posted_head.compare_exchange_weak (previous, posted,
+		std::memory_order_release, std::memory_order_relaxed));
+
+	// Only the post onto an empty stack registers the throttle, and only the
+	// first throttle registered wakes the main loop; later posts are drained
+	// along with it.
+	if (previous == NULL)
+	{
+		std::lock_guard<std::mutex> lock (posting);
+		posting_throttles.push_back (this);
+		if (posting_throttles.size () == 1)
+			posting_dispatcher->emit ();
+	}
+}
+
+
+void
+Throttle::on_dispatch () throw ()
+{
+	// Throttles are taken one at a time, since an action may destroy another.
+	for (;;)
 	{
-		try
+		Throttle *throttle;
 		{
-			action_queue.front () ();
+			std::lock_guard<std::mutex> lock (posting);
+			if (posting_throttles.empty ()) return;
+			throttle = posting_throttles.front ();
+			posting_throttles.pop_front ();
 		}
-		catch (...) {}
-		action_queue.pop ();
+		throttle->on_posted ();
 	}
 }
 
 
 void
-Throttle::run_all () throw ()
+Throttle::on_posted () throw ()
 {
-	while (!action_queue.empty ())
+	Posted *posted = posted_head.exchange (NULL, std::memory_order_acquire);
+
+	// The stack is newest first; reverse it to queue in posting order.
+	Posted *oldest = NULL;
+	while (posted != NULL)
 	{
-		try
+		Posted *next = posted->next;
+		posted->next = oldest;
+		oldest = posted;
+		posted = next;
+	}
+
+	while (oldest != NULL)
+	{
+		Posted *next = oldest->next;
+		if (oldest->entry.keyed)
+			enqueue (oldest->entry, false);
+		else
+			enqueue (oldest->entry, oldest->idempotent);
+		delete oldest;
+		oldest = next;
+	}
+}
+
+
+// A replaced keyed action keeps its predecessor's place in the queue, and time
+// of queueing.
+void
+Throttle::enqueue (Entry& entry, bool idempotent) throw ()
+{
+	++stats.queued;
+
+	if (entry.keyed)
+	{
+		std::unordered_map<Key, ActionQueue::iterator>::iterator found =
+			keyed_actions.find (entry.key);
+		if (found != keyed_actions.end ())
 		{
-			action_queue.front () ();
+			found->second->action = entry.action;
+			++stats.coalesced;
 		}
-		catch (...) {}
-		action_queue.pop ();
+		else
+			keyed_actions[entry.key] =
+				action_queue.insert (action_queue.end (), entry);
+	}
+	else
+	{
+		if (idempotent) clear ();
+		action_queue.push_back (entry);
 	}
+
+	stats.max_depth = std::max (stats.max_depth, action_queue.size ());
+	update (true);
+}
+
+
+// The action is removed before it is called, so that it may queue a successor
+// under its own key.
+void
+Throttle::run_front () throw ()
+{
+	Entry &front = action_queue.front ();
+	Action action = std::move (front.action);
+	gint64 queued_at = front.queued_at;
+	if (front.keyed)
+		keyed_actions.erase (front.key);
+	action_queue.pop_front ();
+
+	gint64 started = g_get_monotonic_time ();
+	try
+	{
+		action ();
+	}
+	catch (...) {}
+	gint64 finished = g_get_monotonic_time ();
+
+	double wait = (started - queued_at) / 1e6,
+		runtime = (finished - started) / 1e6;
+	++stats.run;
+	stats.total_wait += wait;
+	stats.max_wait = std::max (stats.max_wait, wait);
+	stats.total_runtime += runtime;
+	stats.max_runtime = std::max (stats.max_runtime, runtime);
+}
+
+
+void
+Throttle::run_top () throw ()
+{
+	if (!action_queue.empty ())
+		run_front ();
+}
+
+
+void
+Throttle::run_all () throw ()
+{
+	while (!action_queue.empty ())
+		run_front ();
+}
+
+
+void
+Throttle::on_log_timer () throw ()
+{
+	Stats current = get_stats ();
+	g_message ("%s: %lu queued, %lu run, %lu coalesced, %lu dropped, "
+		"depth %lu (max %lu), wait %.1f ms (max %.1f), "
+		"runtime %.1f ms (max %.1f)", log_name.c_str (),
+		current.queued, current.run, current.coalesced, current.dropped,
+		(unsigned long) current.depth, (unsigned long) current.max_depth,
+		current.run ? current.total_wait * 1000.0 / current.run : 0.0,
+		current.max_wait * 1000.0,
+		current.run ? current.total_runtime * 1000.0 / current.run : 0.0,
+		current.max_runtime * 1000.0);
+
+	if (log_interval > 0)
+		log_timer.arm (log_interval);
 }
 
 
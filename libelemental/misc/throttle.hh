@@ -22,9 +22,13 @@
 #ifndef LIBMISC__THROTTLE_HH
 #define LIBMISC__THROTTLE_HH
 
-#include <queue>
+#include "timer-wheel.hh"
+
+#include <atomic>
+#include <list>
 #include <stdexcept>
-#include <sigc++/connection.h>
+#include <string>
+#include <unordered_map>
 #include <sigc++/functors/slot.h>
 #include <glibmm/timer.h>
 
@@ -35,7 +39,11 @@ namespace misc {
 //! Regulates the rate at which functions are called.
 /*! A throttle queues one or more action functors and calls them according to
  * a throttling mode (described in the Mode enumeration). Throttles must be used
- * inside a Glib::MainLoop. Exceptions thrown from actions are discarded. */
+ * inside a Glib::MainLoop; their updates are scheduled in the default
+ * TimerWheel. Exceptions thrown from actions are discarded.
+ *
+ * A throttle must be constructed and used in the thread running the main loop,
+ * except for post(), which may be called from any thread. */
 class Throttle
 {
 public:
@@ -45,6 +53,11 @@ public:
 	 * parameters and sigc::hide_return() if the function returns a value. */
 	typedef sigc::slot<void> Action;
 
+	//! A key identifying actions which supersede one another.
+	/*! Any pointer may be used, such as to the object which an action
+	 * updates. */
+	typedef const void* Key;
+
 	//! A mode for the regulation of action calls.
 	enum Mode {
 		//! Actions are called immediately upon queueing.
@@ -71,7 +84,15 @@ public:
 		 * action also resets the timer. This mode is ideal for idempotent
 		 * background actions performed in response to events which may occur
 		 * rapidly and frequently. */
-		DELAY
+		DELAY,
+		//! Actions are called at a rate adapted to their cost.
+		/*! This is equivalent to the \p LIMIT mode, except that the minimum
+		 * time between action calls is the average time taken by recent calls
+		 * divided by the load (see set_adaptive()), within a minimum and the
+		 * timer threshold. Actions then take up about that fraction of the
+		 * main loop's time. This mode is ideal for interface updates whose
+		 * cost varies with the machine. */
+		ADAPTIVE
 	};
 
 	//! Constructs a new throttle.
@@ -94,9 +115,9 @@ public:
 	
 	//! Returns whether the throttle's internal timer is running.
 	/*! In \p PAUSE and \p UNTIL modes, the timer counts down to the impending
-	 * mode change. In \p LIMIT and \p DELAY modes, the timer counts the time
-	 * elapsed since the last action call. The timer is not used in \p OPEN
-	 * and \p CLOSED modes. */
+	 * mode change. In \p LIMIT, \p DELAY and \p ADAPTIVE modes, the timer
+	 * counts the time elapsed since the last action call. The timer is not
+	 * used in \p OPEN and \p CLOSED modes. */
 	bool is_running () const throw ();
 
 	//! Sets the throttle mode.
@@ -122,6 +143,24 @@ public:
 	 * \param immediate Whether to start the timer immediately in some modes. */
 	void reset (bool immediate = false) throw ();
 
+	//! Sets the throttle to \p ADAPTIVE mode with new bounds.
+	/*! \param load The greatest fraction of time to be spent calling actions,
+	 * greater than zero and at most one.
+	 * \param minimum The least time between action calls in seconds.
+	 * \param maximum The greatest time between action calls in seconds, which
+	 * becomes the timer threshold.
+	 * \throw std::invalid_argument if a bound is invalid. */
+	void set_adaptive (double load, double minimum, double maximum);
+
+	//! Returns the fraction of time to be spent calling actions.
+	//! See set_adaptive() for details.
+	double get_load () const throw ();
+
+	//! Returns the time in seconds currently kept between action calls.
+	/*! In \p ADAPTIVE mode, this is adapted to the cost of the actions;
+	 * otherwise, it is the timer threshold. */
+	double get_effective_threshold () const throw ();
+
 	//! Returns the timer threshold in seconds.
 	//! See set_threshold() for details.
 	double get_threshold () const throw ();
@@ -129,8 +168,9 @@ public:
 	//! Sets the timer threshold.
 	/*! In \p PAUSE and \p UNTIL modes, the threshold is the total time to wait
 	 * before the mode is changed. In \p LIMIT and \p DELAY modes, the threshold
-	 * is the minimum time between action calls. The threshold is not used in
-	 * \p OPEN and \p CLOSED modes.
+	 * is the minimum time between action calls, and in \p ADAPTIVE mode, the
+	 * greatest such time. The threshold is not used in \p OPEN and \p CLOSED
+	 * modes.
 	 * \param threshold The new timer threshold in seconds.
 	 * \throw std::invalid_argument if the threshold is negative. */
 	void set_threshold (double threshold);
@@ -147,7 +187,89 @@ public:
 	 * \param idempotent Whether \p action is idempotent with each action in the
 	 * queue. */
 	void queue (const Action& action, bool idempotent) throw ();
+
+	//! Adds a new functor to the action queue, replacing any with its key.
+	/*! If an action with the same key is already queued, it is replaced by
+	 * \p action, which takes its place in the queue; otherwise \p action is
+	 * added to the end of the queue. Actions with other keys, and those queued
+	 * without keys, are kept. As with queue(), this action or queued actions
+	 * may be called immediately.
+	 * \param action The action functor to be queued for calling.
+	 * \param key The key identifying the actions which \p action supersedes. */
+	void queue (const Action& action, Key key) throw ();
 	
+	//! Adds a new functor to the action queue from any thread.
+	/*! The action is queued, as by queue(const Action&, bool), in the main
+	 * loop's thread. Actions posted from one thread are queued in the order
+	 * they were posted. All throttles share one dispatcher; only the first
+	 * post of a burst made before the main loop drains it takes a lock, and
+	 * wakes the main loop. The throttle must not be destroyed while other
+	 * threads may post to it.
+	 *
+	 * The action is copied in the posting thread and destroyed in the main
+	 * loop's thread. Since copying or destroying a slot bound to a
+	 * sigc::trackable (as by sigc::mem_fun() on a widget) updates the
+	 * trackable without locking, posted actions must not be bound to
+	 * trackables; bind functions and copyable arguments instead, and reach
+	 * any such object from the main loop's thread.
+	 * \param action The action functor to be queued for calling.
+	 * \param idempotent Whether \p action is idempotent with each action in the
+	 * queue. */
+	void post (const Action& action, bool idempotent) throw ();
+
+	//! Adds a new functor to the action queue from any thread, by key.
+	/*! As post(const Action&, bool), but queued as by
+	 * queue(const Action&, Key).
+	 * \param action The action functor to be queued for calling.
+	 * \param key The key identifying the actions which \p action supersedes. */
+	void post (const Action& action, Key key) throw ();
+
+	//! Statistics on the actions of a throttle.
+	/*! The ratio of \p coalesced to \p queued measures how much work keyed
+	 * queueing saves. */
+	struct Stats
+	{
+		//! The number of actions queued or posted.
+		unsigned long queued;
+
+		//! The number of actions called.
+		unsigned long run;
+
+		//! The number of queued actions replaced by others with their key.
+		unsigned long coalesced;
+
+		//! The number of actions removed from the queue without being called.
+		unsigned long dropped;
+
+		//! The number of actions in the queue.
+		std::size_t depth;
+
+		//! The greatest number of actions that have been in the queue.
+		std::size_t max_depth;
+
+		//! The total and greatest time in seconds from queueing an action to
+		//! calling it. A keyed action's time starts when its key was queued.
+		double total_wait, max_wait;
+
+		//! The total and greatest time in seconds taken by action calls.
+		double total_runtime, max_runtime;
+	};
+
+	//! Returns statistics on the throttle's actions since it was constructed
+	//! or its statistics were last reset.
+	Stats get_stats () const throw ();
+
+	//! Discards the throttle's statistics.
+	void reset_stats () throw ();
+
+	//! Logs the throttle's statistics periodically.
+	/*! The statistics are written as a message in the "libmisc" log domain.
+	 * \param name The name identifying the throttle in the log.
+	 * \param interval The time between messages in seconds, or zero to stop
+	 * logging.
+	 * \throw std::invalid_argument if the interval is negative. */
+	void set_stats_log (const std::string& name, double interval);
+
 	//! Returns whether the action queue is empty.
 	bool empty () const throw ();
 	
@@ -162,20 +284,60 @@ private:
 	void stop () throw ();
 
 	bool update (bool from_queue = false) throw ();
+	void on_update_timer () throw ();
 	void request_update (unsigned int interval = 0) throw ();
 	void cancel_update () throw ();
 	
 	void run_top () throw ();
 	void run_all () throw ();
+	void measure (double elapsed) throw ();
 
 	Mode mode;
 	double threshold;
 
+	// The ADAPTIVE mode's bounds, and the moving average cost of an action.
+	double load, minimum;
+	double cost;
+
 	Glib::Timer timer;
 	bool running;
 
-	std::queue<Action> action_queue;
-	sigc::connection update_conn;
+	struct Entry
+	{
+		Action action;
+		Key key;
+		bool keyed;
+		gint64 queued_at;
+	};
+
+	typedef std::list<Entry> ActionQueue;
+	ActionQueue action_queue;
+	std::unordered_map<Key, ActionQueue::iterator> keyed_actions;
+	TimerWheel::Timer update_timer;
+
+	void enqueue (Entry& entry, bool idempotent) throw ();
+	void run_front () throw ();
+
+	// Actions posted from other threads, pushed onto a lock-free stack and
+	// drained in the main loop's thread by the shared dispatcher.
+	struct Posted
+	{
+		Entry entry;
+		bool idempotent;
+		Posted *next;
+	};
+
+	void push_posted (Posted *posted) throw ();
+	void on_posted () throw ();
+	static void on_dispatch () throw ();
+
+	std::atomic<Posted*> posted_head;
+
+	Stats stats;
+	TimerWheel::Timer log_timer;
+	std::string log_name;
+	unsigned int log_interval;
+	void on_log_timer () throw ();
 };
 
 } // namespace misc
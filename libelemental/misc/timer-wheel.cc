@@ -0,0 +1,357 @@
+/*
+ * This file is part of libmisc, an assortment of code for reuse.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hh"
+
+#include <algorithm>
+#include <glibmm/main.h>
+
+namespace misc {
+
+// The wheel has LEVELS levels of SLOTS slots each. A slot of level n holds the
+// timers expiring within one span of SLOTS^n milliseconds, which are moved to
+// lower levels ("cascaded") when that span begins.
+
+
+// Returns the offset from a slot to the first occupied slot at or after it,
+// wrapping around. At least one slot must be occupied.
+static inline unsigned int
+first_occupied (guint64 occupied, unsigned int from) throw ()
+{
+	guint64 rotated = from ? (occupied >> from) | (occupied << (64 - from))
+		: occupied;
+	return __builtin_ctzll (rotated);
+}
+
+
+//******************************************************************************
+// class TimerWheel::Source
+
+
+class TimerWheel::Source
+:	public Glib::Source
+{
+public:
+
+	explicit Source (TimerWheel& wheel_)
+	:	wheel (wheel_)
+	{}
+
+protected:
+
+	virtual bool
+	prepare (int& timeout)
+	{
+		gint64 next = wheel.next_event ();
+		if (next == G_MAXINT64)
+		{
+			timeout = -1;
+			return false;
+		}
+
+		gint64 wait = next - TimerWheel::now ();
+		timeout = int (std::max<gint64> (0, std::min<gint64> (wait, G_MAXINT)));
+		return wait <= 0;
+	}
+
+	virtual bool
+	check ()
+	{
+		return wheel.next_event () <= TimerWheel::now ();
+	}
+
+	virtual bool
+	dispatch (sigc::slot_base*)
+	{
+		wheel.advance (TimerWheel::now ());
+		return true;
+	}
+
+private:
+
+	TimerWheel &wheel;
+};
+
+
+//******************************************************************************
+// class TimerWheel
+
+
+const unsigned int TimerWheel::SLOT_BITS;
+const unsigned int TimerWheel::SLOTS;
+const unsigned int TimerWheel::LEVELS;
+
+
+inline void
+TimerWheel::unlink (Link& link) throw ()
+{
+	link.prev->next = link.next;
+	link.next->prev = link.prev;
+	link.prev = link.next = &link;
+}
+
+
+inline void
+TimerWheel::link_before (Link& link, Link& list) throw ()
+{
+	link.prev = list.prev;
+	link.next = &list;
+	list.prev->next = &link;
+	list.prev = &link;
+}
+
+
+TimerWheel&
+TimerWheel::get_default ()
+{
+	// Never destroyed, as timers may outlive static destruction.
+	static TimerWheel *wheel = new TimerWheel ();
+	return *wheel;
+}
+
+
+TimerWheel::TimerWheel ()
+:	current (now ()), count (0)
+{
+	for (unsigned int level = 0; level < LEVELS; ++level)
+	{
+		occupied[level] = 0;
+		for (unsigned int slot = 0; slot < SLOTS; ++slot)
+			slots[level][slot].prev = slots[level][slot].next =
+				&slots[level][slot];
+	}
+}
+
+
+gint64
+TimerWheel::now () throw ()
+{
+	return g_get_monotonic_time () / 1000;
+}
+
+
+void
+TimerWheel::arm (Timer& timer, unsigned int interval) throw ()
+{
+	if (timer.armed)
+		remove (timer);
+	else
+	{
+		// An empty wheel has nothing to catch up on.
+		if (count++ == 0)
+			current = std::max (current, now ());
+		timer.armed = true;
+	}
+
+	timer.deadline = std::max (now () + interval, current + 1);
+	insert (timer);
+
+	if (!source)
+	{
+		source = Glib::RefPtr<Source> (new Source (*this));
+		source->attach (Glib::MainContext::get_default ());
+	}
+}
+
+
+void
+TimerWheel::cancel (Timer& timer) throw ()
+{
+	if (!timer.armed) return;
+	remove (timer);
+	timer.armed = false;
+	--count;
+}
+
+
+void
+TimerWheel::insert (Timer& timer) throw ()
+{
+	// Timers beyond the top level's reach are re-inserted as it is reached.
+	const gint64 span = gint64 (1) << (SLOT_BITS * LEVELS);
+	gint64 expires = std::min (timer.deadline, current + span - 1),
+		delta = expires - current;
+
+	unsigned int level = 0;
+	while (level < LEVELS - 1 && delta >= gint64 (1) << (SLOT_BITS * (level + 1)))
+		++level;
+	unsigned int slot = (expires >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+	link_before (timer, slots[level][slot]);
+	occupied[level] |= guint64 (1) << slot;
+	timer.level = level;
+	timer.index = slot;
+}
+
+
+void
+TimerWheel::remove (Timer& timer) throw ()
+{
+	unlink (timer);
+
+	// Timers being expired or cascaded are in no slot.
+	if (timer.level < LEVELS)
+	{
+		Link &list = slots[timer.level][timer.index];
+		if (list.next == &list)
+			occupied[timer.level] &= ~(guint64 (1) << timer.index);
+	}
+}
+
+
+void
+TimerWheel::detach (unsigned int level, unsigned int slot, Link& list) throw ()
+{
+	Link &source_list = slots[level][slot];
+	if (source_list.next == &source_list)
+		list.prev = list.next = &list;
+	else
+	{
+		list.next = source_list.next;
+		list.prev = source_list.prev;
+		list.next->prev = list.prev->next = &list;
+		source_list.prev = source_list.next = &source_list;
+	}
+	occupied[level] &= ~(guint64 (1) << slot);
+
+	for (Link *link = list.next; link != &list; link = link->next)
+		static_cast<Timer*> (link)->level = LEVELS;
+}
+
+
+gint64
+TimerWheel::next_event () const throw ()
+{
+	if (count == 0) return G_MAXINT64;
+
+	gint64 result = G_MAXINT64;
+
+	// The level-0 slots hold the timers of the coming SLOTS milliseconds.
+	if (occupied[0] != 0)
+		result = current + first_occupied (occupied[0], current & (SLOTS - 1));
+
+	// Higher levels have their next occupied span cascaded when it begins.
+	for (unsigned int level = 1; level < LEVELS; ++level)
+		if (occupied[level] != 0)
+		{
+			gint64 span = current >> (SLOT_BITS * level);
+			unsigned int from = (span + 1) & (SLOTS - 1);
+			gint64 start = (span + 1 + first_occupied (occupied[level], from))
+				<< (SLOT_BITS * level);
+			result = std::min (result, start);
+		}
+
+	return result;
+}
+
+
+void
+TimerWheel::advance (gint64 until) throw ()
+{
+	while (current < until)
+	{
+		// Skip directly to the next time at which anything happens.
+		gint64 next = next_event ();
+		if (next > until)
+		{
+			current = until;
+			break;
+		}
+		current = next;
+
+		for (unsigned int level = LEVELS - 1; level > 0; --level)
+		{
+			if ((current & ((gint64 (1) << (SLOT_BITS * level)) - 1)) != 0)
+				continue;
+
+			Link cascading;
+			detach (level, (current >> (SLOT_BITS * level)) & (SLOTS - 1),
+				cascading);
+			while (cascading.next != &cascading)
+			{
+				Timer &timer = *static_cast<Timer*> (cascading.next);
+				unlink (timer);
+				insert (timer);
+			}
+		}
+
+		Link expiring;
+		detach (0, current & (SLOTS - 1), expiring);
+		while (expiring.next != &expiring)
+		{
+			Timer &timer = *static_cast<Timer*> (expiring.next);
+			unlink (timer);
+
+			if (timer.deadline > current)
+				insert (timer);
+			else
+			{
+				timer.armed = false;
+				--count;
+				try
+				{
+					timer.slot ();
+				}
+				catch (...) {}
+			}
+		}
+	}
+}
+
+
+//******************************************************************************
+// class TimerWheel::Timer
+
+
+TimerWheel::Timer::Timer (const Slot& slot_, TimerWheel& wheel_)
+:	wheel (wheel_), slot (slot_), deadline (0), armed (false),
+	level (LEVELS), index (0)
+{
+	prev = next = this;
+}
+
+
+TimerWheel::Timer::~Timer ()
+{
+	cancel ();
+}
+
+
+void
+TimerWheel::Timer::arm (unsigned int interval) throw ()
+{
+	wheel.arm (*this, interval);
+}
+
+
+void
+TimerWheel::Timer::cancel () throw ()
+{
+	wheel.cancel (*this);
+}
+
+
+bool
+TimerWheel::Timer::is_armed () const throw ()
+{
+	return armed;
+}
+
+
+} // namespace misc
@@ -0,0 +1,137 @@
+//! \file timer-wheel.hh
+//! TimerWheel schedules many timed callbacks with a single main loop source.
+/*
+ * This file is part of libmisc, an assortment of code for reuse.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This library is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBMISC__TIMER_WHEEL_HH
+#define LIBMISC__TIMER_WHEEL_HH
+
+#include <sigc++/functors/slot.h>
+#include <glibmm/refptr.h>
+#include <glib.h>
+
+//******************************************************************************
+
+namespace misc {
+
+//! Schedules timed callbacks in a Glib::MainLoop.
+/*! Timers are kept in a hierarchical timer wheel of millisecond resolution,
+ * driven by a single main loop source which wakes only for the earliest
+ * deadline. Arming, re-arming and cancelling a timer take constant time, and
+ * add or remove no main loop sources. A timer wheel and its timers must only be
+ * used from the thread running the default main context. */
+class TimerWheel
+{
+public:
+
+	class Timer;
+
+	//! Returns the timer wheel of the default main context.
+	static TimerWheel& get_default ();
+
+private:
+
+	struct Link
+	{
+		Link *prev, *next;
+	};
+
+	class Source;
+
+	static const unsigned int SLOT_BITS = 6;
+	static const unsigned int SLOTS = 1 << SLOT_BITS;
+	static const unsigned int LEVELS = 4;
+
+	TimerWheel ();
+	TimerWheel (const TimerWheel&) = delete;
+	TimerWheel& operator= (const TimerWheel&) = delete;
+
+	static gint64 now () throw ();
+
+	static inline void unlink (Link& link) throw ();
+	static inline void link_before (Link& link, Link& list) throw ();
+
+	void arm (Timer& timer, unsigned int interval) throw ();
+	void cancel (Timer& timer) throw ();
+
+	void insert (Timer& timer) throw ();
+	void remove (Timer& timer) throw ();
+	void detach (unsigned int level, unsigned int slot, Link& list) throw ();
+
+	gint64 next_event () const throw ();
+	void advance (gint64 until) throw ();
+
+	Link slots[LEVELS][SLOTS];
+	guint64 occupied[LEVELS];
+	gint64 current;
+	unsigned int count;
+	Glib::RefPtr<Source> source;
+};
+
+//******************************************************************************
+
+//! A callback called by a TimerWheel once a time interval has elapsed.
+/*! Exceptions thrown from the callback are discarded. */
+class TimerWheel::Timer
+:	private TimerWheel::Link
+{
+public:
+
+	//! A functor to be called when the timer expires.
+	typedef sigc::slot<void> Slot;
+
+	//! Constructs a new timer, which is not armed.
+	/*! \param slot The functor to be called when the timer expires.
+	 * \param wheel The timer wheel in which to schedule the timer. */
+	explicit Timer (const Slot& slot,
+		TimerWheel& wheel = TimerWheel::get_default ());
+
+	//! Destroys the timer, cancelling it if it is armed.
+	~Timer ();
+
+	//! Schedules the timer to expire after an interval.
+	/*! If the timer is already armed, its previous deadline is replaced.
+	 * \param interval The interval in milliseconds. The timer expires no
+	 * sooner than the next main loop iteration. */
+	void arm (unsigned int interval) throw ();
+
+	//! Cancels the timer, if it is armed.
+	void cancel () throw ();
+
+	//! Returns whether the timer is armed.
+	bool is_armed () const throw ();
+
+private:
+
+	friend class TimerWheel;
+
+	Timer (const Timer&) = delete;
+	Timer& operator= (const Timer&) = delete;
+
+	TimerWheel &wheel;
+	Slot slot;
+
+	gint64 deadline;
+	bool armed;
+	unsigned int level, index;
+};
+
+} // namespace misc
+
+#endif // LIBMISC__TIMER_WHEEL_HH
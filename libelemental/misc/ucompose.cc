@@ -21,6 +21,8 @@
 
 #include "ucompose.hh"
 
+#include <cstring>
+
 namespace compose {
 
 
@@ -119,6 +121,14 @@ UComposition::precision (std::streamsize prec)
 }
 
 
+UComposition&
+UComposition::imbue (const std::locale &loc)
+{
+	os.imbue (loc);
+	return *this;
+}
+
+
 void
 UComposition::do_arg (const ustring &rep)
 {
@@ -148,4 +158,91 @@ UComposition::do_stringify (const std::wstring& src)
 }
 
 
+//******************************************************************************
+// class Argument
+
+
+// Whether a std::wostringstream in the global locale would format integers (or
+// also fractional numbers) exactly as std::to_chars does.
+bool
+Argument::is_plain_locale (bool fractional)
+{
+	std::locale global;
+	const std::numpunct<wchar_t> &punct =
+		std::use_facet<std::numpunct<wchar_t> > (global);
+	if (fractional && punct.decimal_point () != L'.')
+		return false;
+	return punct.grouping ().empty ();
+}
+
+
+void
+Argument::convert (const std::wstring &src)
+{
+	storage = Glib::convert (string (reinterpret_cast<const char *>
+		(src.data ()), src.size () * sizeof (wchar_t)), "UTF-8", "WCHAR_T");
+	text = storage;
+}
+
+
+//******************************************************************************
+
+
+// Writes the composition to out, if it is not NULL, and returns its length.
+// The format string is parsed as UComposition parses it.
+static std::size_t
+compose_into (const char *fmt, std::size_t length,
+	const std::string_view *texts, std::size_t count, char *out)
+{
+	std::size_t size = 0, i = 0, b = 0;
+
+	while (i < length)
+	{
+		if (fmt[i] != '%' || i + 1 == length)
+			{ ++i; continue; }
+
+		if (fmt[i + 1] == '%') // %% is a single %
+		{
+			if (out) std::memcpy (out + size, fmt + b, i + 1 - b);
+			size += i + 1 - b;
+			i += 2;
+			b = i;
+		}
+		else if (fmt[i + 1] >= '0' && fmt[i + 1] <= '9') // a spec
+		{
+			if (out) std::memcpy (out + size, fmt + b, i - b);
+			size += i - b;
+
+			std::size_t spec_no = 0;
+			for (++i; i < length && fmt[i] >= '0' && fmt[i] <= '9'; ++i)
+				if (spec_no <= count)
+					spec_no = spec_no * 10 + (fmt[i] - '0');
+
+			if (spec_no >= 1 && spec_no <= count)
+			{
+				const std::string_view &text = texts[spec_no - 1];
+				if (out) std::memcpy (out + size, text.data (), text.size ());
+				size += text.size ();
+			}
+			b = i;
+		}
+		else
+			++i;
+	}
+
+	if (out) std::memcpy (out + size, fmt + b, length - b);
+	return size + length - b;
+}
+
+
+ustring
+compose_texts (const char *fmt, std::size_t length,
+	const std::string_view *texts, std::size_t count)
+{
+	string result (compose_into (fmt, length, texts, count, NULL), '\0');
+	compose_into (fmt, length, texts, count, &result[0]);
+	return ustring (std::move (result));
+}
+
+
 } // namespace compose
@@ -36,10 +36,14 @@
 #ifndef LIBMISC__UCOMPOSE_HH
 #define LIBMISC__UCOMPOSE_HH
 
+#include <charconv>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <list>
+#include <locale>
 #include <map>
+#include <type_traits>
 #include <glibmm/convert.h>
 #include <glibmm/ustring.h>
 
@@ -75,6 +79,9 @@ public:
 	//! Set precision for future arguments.
 	UComposition& precision (std::streamsize prec);
 
+	//! Set the locale for future arguments.
+	UComposition& imbue (const std::locale &loc);
+
 private:
 
 	void do_arg (const ustring &rep);
@@ -101,6 +108,44 @@ private:
 	specification_map specs;
 };
 
+//******************************************************************************
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+// One argument to compose::ucompose(), formatted as UTF-8. Strings are viewed
+// in place; numbers are formatted without streams where the global locale
+// formats them as the "C" locale does.
+class Argument
+{
+public:
+
+	template<typename T> explicit inline Argument (const T &obj);
+
+	std::string_view get_text () const throw () { return text; }
+
+private:
+
+	Argument (const Argument&) = delete;
+	Argument& operator= (const Argument&) = delete;
+
+	template<typename T> inline void format_number (T value);
+	template<typename T> inline void format_stream (const T &obj);
+
+	static bool is_plain_locale (bool fractional);
+	void convert (const std::wstring &src);
+
+	std::string_view text;
+	std::string storage;
+	char digits[32];
+};
+
+// Composes from a format string and the texts of the arguments which were not
+// empty; %n refers to texts[n - 1].
+ustring compose_texts (const char *fmt, std::size_t length,
+	const std::string_view *texts, std::size_t count);
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 } // namespace compose
 
 #include "ucompose.tcc"
@@ -86,218 +86,117 @@ UComposition::stringify<char *> (char *obj)
 }
 
 
-#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 
 //******************************************************************************
-//! \name UTF-8 Composition Functions
-//@{
-
-
-template<typename  T1>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1)
-{
-	UComposition c (fmt);
-	c.arg (o1);
-	return c.str ();
-}
+// class Argument
 
 
-template<typename  T1, typename  T2>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3, typename  T4>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7);
-	return c.str ();
-}
-
-
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8)
+template<typename T>
+inline
+Argument::Argument (const T &obj)
+{
+	if constexpr (std::is_same<T, ustring>::value)
+		text = obj.raw ();
+	else if constexpr (std::is_same<T, string>::value)
+		text = obj;
+	else if constexpr (std::is_convertible<const T&, const char*>::value)
+		text = static_cast<const char*> (obj);
+	else if constexpr (std::is_same<T, bool>::value ||
+		std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+		std::is_same<T, unsigned char>::value || std::is_same<T, wchar_t>::value ||
+		std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value)
+		format_stream (obj);
+	else if constexpr (std::is_integral<T>::value)
+	{
+		if (is_plain_locale (false))
+			format_number (obj);
+		else
+			format_stream (obj);
+	}
+	else if constexpr (std::is_same<T, float>::value ||
+		std::is_same<T, double>::value)
+	{
+		if (is_plain_locale (true))
+			format_number (double (obj));
+		else
+			format_stream (obj);
+	}
+	else
+		format_stream (obj);
+}
+
+
+// Formats as an unmodified std::wostringstream would: integers in decimal, and
+// floating-point numbers with six significant digits, as by printf's %g.
+template<typename T>
+inline void
+Argument::format_number (T value)
 {
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8);
-	return c.str ();
+	std::to_chars_result result;
+	if constexpr (std::is_floating_point<T>::value)
+		result = std::to_chars (digits, digits + sizeof digits, value,
+			std::chars_format::general, 6);
+	else
+		result = std::to_chars (digits, digits + sizeof digits, value);
+	text = std::string_view (digits, result.ptr - digits);
 }
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9)
+template<typename T>
+inline void
+Argument::format_stream (const T &obj)
 {
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9);
-	return c.str ();
+	std::wostringstream os;
+	os << obj;
+	convert (os.str ());
 }
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10>
+template<typename T1, typename... Tn>
 inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10)
+compose_arguments (const char *fmt, std::size_t length,
+	const T1 &o1, const Tn&... on)
 {
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10);
-	return c.str ();
-}
+	const Argument args[] = { Argument (o1), Argument (on)... };
 
+	std::string_view texts[1 + sizeof... (Tn)];
+	std::size_t count = 0;
+	for (const Argument &arg : args)
+		if (!arg.get_text ().empty ())
+			texts[count++] = arg.get_text ();
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10,
-         typename T11>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10, const T11 &o11)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10).arg (o11);
-	return c.str ();
+	return compose_texts (fmt, length, texts, count);
 }
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10,
-         typename T11, typename T12>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10, const T11 &o11, const T12 &o12)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10).arg (o11).arg (o12);
-	return c.str ();
-}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10,
-         typename T11, typename T12, typename T13>
-inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10, const T11 &o11, const T12 &o12,
-          const T13 &o13)
-{
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10).arg (o11).arg (o12).arg (o13);
-	return c.str ();
-}
+//******************************************************************************
+//! \name UTF-8 Composition Functions
+//@{
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10,
-         typename T11, typename T12, typename T13, typename T14>
+//! Composes a string from a format string and any number of arguments.
+/*! Each %\e n in the format string is replaced by the \e n th argument, and
+ * each %% by a single %. As with UComposition, arguments which format to
+ * empty strings are skipped, so that the next argument takes their number. */
+template<typename T1, typename... Tn>
 inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10, const T11 &o11, const T12 &o12,
-          const T13 &o13, const T14 &o14)
+ucompose (const char *fmt, const T1 &o1, const Tn&... on)
 {
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10).arg (o11).arg (o12).arg (o13).arg (o14);
-	return c.str ();
+	return compose_arguments (fmt, std::char_traits<char>::length (fmt),
+		o1, on...);
 }
 
 
-template<typename  T1, typename  T2, typename  T3, typename  T4, typename  T5,
-         typename  T6, typename  T7, typename  T8, typename  T9, typename T10,
-         typename T11, typename T12, typename T13, typename T14, typename T15>
+//! Composes a string from a format string and any number of arguments.
+template<typename T1, typename... Tn>
 inline ustring
-ucompose (const ustring &fmt,
-          const  T1  &o1, const  T2  &o2, const  T3  &o3, const  T4  &o4,
-          const  T5  &o5, const  T6  &o6, const  T7  &o7, const  T8  &o8,
-          const  T9  &o9, const T10 &o10, const T11 &o11, const T12 &o12,
-          const T13 &o13, const T14 &o14, const T15 &o15)
+ucompose (const ustring &fmt, const T1 &o1, const Tn&... on)
 {
-	UComposition c (fmt);
-	c.arg (o1).arg (o2).arg (o3).arg (o4).arg (o5).arg (o6).arg (o7).arg (o8).arg (o9)
-		.arg (o10).arg (o11).arg (o12).arg (o13).arg (o14).arg (o15);
-	return c.str ();
+	return compose_arguments (fmt.data (), fmt.bytes (), o1, on...);
 }
 
 
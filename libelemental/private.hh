@@ -35,6 +35,11 @@
 
 namespace Elemental {
 
+// Appends text with Pango markup removed: tags are dropped and entities are
+// replaced by the characters they represent. Returns false, having appended
+// part of the text, if the markup is malformed. Defined in value.cc.
+bool append_unmarked (std::string& dest, const std::string& src) throw ();
+
 class Tango
 {
 public:
@@ -30,9 +30,9 @@ namespace Elemental {
 
 #	define Src(SRC, desc) static const Message SRC = desc
 #	define Cat(CAT, name, ...) \
-Category C_##CAT (name, (PropertyBase*[]) { __VA_ARGS__, NULL })
+Category C_##CAT (#CAT, name, (PropertyBase*[]) { __VA_ARGS__, NULL })
 #	define Prop(PROP, type, name, format, desc, ...) Property<type> P_##PROP \
-(name, format, desc, (const Message*[]) { __VA_ARGS__, NULL})
+(#PROP, name, format, desc, (const Message*[]) { __VA_ARGS__, NULL})
 
 #else // Doxygen
 
@@ -0,0 +1,227 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "private.hh"
+#include <libelemental/stats.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace Elemental {
+
+
+static const char* const PROBE_NAMES[] =
+{
+	"get_element", "get_property_base", "get_string", "compare",
+	"make_entries", "make_category_entries", "write_entry"
+};
+
+static const char* const COUNTER_NAMES[] =
+{
+	"catalog_hit", "catalog_miss"
+};
+
+
+struct ProbeData
+{
+	std::atomic<unsigned long> calls;
+	std::atomic<unsigned long> total_ns;
+	std::atomic<unsigned long> buckets[Stats::BUCKET_COUNT];
+};
+
+// Zero-initialized before any dynamic initialization.
+static ProbeData probes[Stats::PROBE_COUNT];
+static std::atomic<unsigned long> counters[Stats::COUNTER_COUNT];
+
+// Which probes are being timed on this thread.
+static thread_local bool timing[Stats::PROBE_COUNT];
+
+
+static long
+now_ns () throw ()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>
+		(std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+
+//******************************************************************************
+// class Stats
+
+
+const unsigned int Stats::BUCKET_COUNT;
+
+std::atomic<bool> Stats::enabled (false);
+
+
+void
+Stats::set_enabled (bool enabled_) throw ()
+{
+	enabled.store (enabled_, std::memory_order_relaxed);
+}
+
+
+void
+Stats::reset () throw ()
+{
+	for (unsigned int probe = 0; probe < PROBE_COUNT; ++probe)
+	{
+		probes[probe].calls.store (0, std::memory_order_relaxed);
+		probes[probe].total_ns.store (0, std::memory_order_relaxed);
+		for (unsigned int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+			probes[probe].buckets[bucket].store (0, std::memory_order_relaxed);
+	}
+
+	for (unsigned int counter = 0; counter < COUNTER_COUNT; ++counter)
+		counters[counter].store (0, std::memory_order_relaxed);
+}
+
+
+Stats::Histogram
+Stats::get_histogram (Probe probe) throw ()
+{
+	const ProbeData &data = probes[probe];
+
+	Histogram result;
+	result.calls = data.calls.load (std::memory_order_relaxed);
+	result.total_ns = data.total_ns.load (std::memory_order_relaxed);
+	for (unsigned int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		result.buckets[bucket] =
+			data.buckets[bucket].load (std::memory_order_relaxed);
+	return result;
+}
+
+
+unsigned long
+Stats::get_counter (Counter counter) throw ()
+{
+	return counters[counter].load (std::memory_order_relaxed);
+}
+
+
+const char*
+Stats::get_name (Probe probe) throw ()
+{
+	return PROBE_NAMES[probe];
+}
+
+
+const char*
+Stats::get_name (Counter counter) throw ()
+{
+	return COUNTER_NAMES[counter];
+}
+
+
+void
+Stats::dump (std::ostream& os)
+{
+	os << "{\"probes\":{";
+	for (unsigned int probe = 0; probe < PROBE_COUNT; ++probe)
+	{
+		Histogram histogram = get_histogram (Probe (probe));
+		os << (probe ? ",\n" : "\n") << '"' << PROBE_NAMES[probe]
+			<< "\":{\"calls\":" << histogram.calls
+			<< ",\"total_ns\":" << histogram.total_ns << ",\"buckets\":[";
+		for (unsigned int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+			os << (bucket ? "," : "") << histogram.buckets[bucket];
+		os << "]}";
+	}
+
+	os << "},\n\"counters\":{";
+	for (unsigned int counter = 0; counter < COUNTER_COUNT; ++counter)
+		os << (counter ? "," : "") << '"' << COUNTER_NAMES[counter] << "\":"
+			<< get_counter (Counter (counter));
+	os << "}}\n";
+}
+
+
+void
+Stats::do_count (Counter counter) throw ()
+{
+	counters[counter].fetch_add (1, std::memory_order_relaxed);
+}
+
+
+//******************************************************************************
+// class Stats::Timer
+
+
+void
+Stats::Timer::begin () throw ()
+{
+	if (timing[probe]) return;
+	timing[probe] = true;
+	start = now_ns ();
+}
+
+
+void
+Stats::Timer::end () throw ()
+{
+	unsigned long elapsed = now_ns () - start;
+	timing[probe] = false;
+
+	unsigned int bucket = 0;
+	while (bucket < BUCKET_COUNT - 1 && (elapsed >> bucket) != 0)
+		++bucket;
+
+	ProbeData &data = probes[probe];
+	data.calls.fetch_add (1, std::memory_order_relaxed);
+	data.total_ns.fetch_add (elapsed, std::memory_order_relaxed);
+	data.buckets[bucket].fetch_add (1, std::memory_order_relaxed);
+}
+
+
+//******************************************************************************
+// ELEMENTAL_STATS
+
+
+// Enables statistics when the library is loaded, and dumps them at exit, if the
+// environment variable is set.
+static struct StatsFromEnvironment
+{
+	StatsFromEnvironment ()
+	:	path (std::getenv ("ELEMENTAL_STATS"))
+	{
+		if (path != NULL)
+			Stats::set_enabled (true);
+	}
+
+	~StatsFromEnvironment ()
+	{
+		if (path == NULL) return;
+
+		if (std::string (path) == "-" || *path == '\0')
+			Stats::dump (std::cerr);
+		else
+		{
+			std::ofstream file (path);
+			Stats::dump (file);
+		}
+	}
+
+	const char *path;
+} stats_from_environment;
+
+
+} // namespace Elemental
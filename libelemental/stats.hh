@@ -0,0 +1,179 @@
+//! \file stats.hh
+//! Call counts and latency histograms of library functions.
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBELEMENTAL__STATS_HH
+#define LIBELEMENTAL__STATS_HH
+
+#include <atomic>
+#include <ostream>
+#include <glib.h>
+
+//******************************************************************************
+
+namespace Elemental {
+
+//! Statistics on the use of the library.
+/*! While statistics are enabled, the library counts calls to its frequently
+ * used functions, collects histograms of their latencies, and counts the hits
+ * and misses of its caches. While they are disabled, which is the default,
+ * each instrumented call costs one predicted-false branch.
+ *
+ * If the ELEMENTAL_STATS environment variable is set when the library is
+ * loaded, statistics are enabled, and dumped when the process exits to the
+ * file it names, or to standard error if it is "-". */
+class Stats
+{
+public:
+
+	//! The instrumented functions.
+	enum Probe
+	{
+		GET_ELEMENT, //!< get_element()
+		GET_PROPERTY_BASE, //!< Element::get_property_base()
+		GET_STRING, //!< value_base::get_string() and overrides
+		COMPARE, //!< value_base::compare() and overrides
+		MAKE_ENTRIES, //!< Element::make_entries(), for all categories
+		MAKE_CATEGORY_ENTRIES, //!< Element::make_entries(), for a category
+		WRITE_ENTRY, //!< EntriesStream and EntriesWriter entries
+		PROBE_COUNT
+	};
+
+	//! The counted events.
+	enum Counter
+	{
+		CATALOG_HIT, //!< a message found in a context's catalog
+		CATALOG_MISS, //!< a message looked up with gettext instead
+		COUNTER_COUNT
+	};
+
+	//! The number of buckets in a latency histogram.
+	/*! Bucket \e n counts calls taking less than 2<sup>\e n</sup> ns, and at
+	 * least 2<sup>\e n - 1</sup> ns for \e n > 0; the last bucket also counts
+	 * all longer calls. */
+	static const unsigned int BUCKET_COUNT = 32;
+
+	//! The statistics of one instrumented function.
+	struct Histogram
+	{
+		//! The number of calls.
+		unsigned long calls;
+
+		//! The total latency of the calls, in nanoseconds.
+		unsigned long total_ns;
+
+		//! The number of calls by latency.
+		unsigned long buckets[BUCKET_COUNT];
+	};
+
+	//! Returns whether statistics are being collected.
+	static inline bool is_enabled () throw ();
+
+	//! Starts or stops collecting statistics.
+	//! Statistics already collected are kept.
+	static void set_enabled (bool enabled) throw ();
+
+	//! Discards all statistics collected.
+	static void reset () throw ();
+
+	//! Returns the statistics of an instrumented function.
+	static Histogram get_histogram (Probe probe) throw ();
+
+	//! Returns the number of times an event has occurred.
+	static unsigned long get_counter (Counter counter) throw ();
+
+	//! Returns the name of an instrumented function, such as "get_element".
+	static const char* get_name (Probe probe) throw ();
+
+	//! Returns the name of an event, such as "catalog_hit".
+	static const char* get_name (Counter counter) throw ();
+
+	//! Writes all statistics collected as a JSON object.
+	static void dump (std::ostream& os);
+
+	//! Counts an event.
+	static inline void count (Counter counter) throw ();
+
+	//! Times a call to an instrumented function for its own lifetime.
+	/*! A call made within another call to the same function on the same
+	 * thread is not timed separately. */
+	class Timer
+	{
+	public:
+
+		//! Starts timing, if statistics are enabled.
+		explicit inline Timer (Probe probe) throw ();
+
+		//! Records the call, if it was being timed.
+		inline ~Timer ();
+
+	private:
+
+		void begin () throw ();
+		void end () throw ();
+
+		Probe probe;
+		long start;
+	};
+
+private:
+
+	static void do_count (Counter counter) throw ();
+
+	static std::atomic<bool> enabled;
+};
+
+//******************************************************************************
+
+inline bool
+Stats::is_enabled () throw ()
+{
+	return G_UNLIKELY (enabled.load (std::memory_order_relaxed));
+}
+
+
+inline void
+Stats::count (Counter counter) throw ()
+{
+	if (is_enabled ())
+		do_count (counter);
+}
+
+
+inline
+Stats::Timer::Timer (Probe probe_) throw ()
+:	probe (probe_), start (0)
+{
+	if (is_enabled ())
+		begin ();
+}
+
+
+inline
+Stats::Timer::~Timer ()
+{
+	if (G_UNLIKELY (start != 0))
+		end ();
+}
+
+} // namespace Elemental
+
+#endif // LIBELEMENTAL__STATS_HH
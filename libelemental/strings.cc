@@ -0,0 +1,101 @@
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "private.hh"
+#include "strings.hh"
+
+namespace Elemental {
+
+
+const char* const library_strings[S_COUNT] =
+{
+// Formats
+
+	// Translators: This is the format for indicating the name of an entry.
+	N_("%1:"),
+	N_("%1 Properties"),
+	N_("%1 (%2)"),
+	// Translators: This is the separator for items in a list.
+	N_(", "),
+	// Translators: This replaces an entry whose value could not be read.
+	N_("Invalid markup in \"%1\""),
+
+// Qualifiers
+
+	N_("(unknown)"),
+	N_("(n/a)"),
+	// Translators: "(%1)" represents an estimated or calculated value.
+	N_("(%1)"),
+	// Translators: "~%1" represents an approximate value.
+	N_("~%1"),
+	// Translators: "[%1]" represents a value for a most stable isotope.
+	N_("[%1]"),
+	// Translators: "(?) %1" prefixes a string indicating an inexact value.
+	N_("(?) %1"),
+	N_("Estimated or calculated value"),
+	N_("Approximate"),
+	N_("Value for most stable isotope"),
+
+// Event
+
+	N_("Undiscovered"),
+	N_("Known to the ancients"),
+
+// Series
+
+	N_("Nonmetals"),
+	N_("Noble gases"),
+	N_("Alkali metals"),
+	N_("Alkaline earth metals"),
+	N_("Semimetals"),
+	N_("Halogens"),
+	N_("Post-transition metals"),
+	N_("Transition metals"),
+	N_("Lanthanides"),
+	N_("Actinides"),
+
+// Block
+
+	N_("s-block"),
+	N_("p-block"),
+	N_("d-block"),
+	N_("f-block"),
+
+// Phase
+
+	N_("Solid"),
+	N_("Liquid"),
+	N_("Gas"),
+
+// LatticeType
+
+	N_("Triclinic"),
+	N_("Monoclinic"),
+	N_("Orthorhombic"),
+	N_("Tetragonal"),
+	N_("Rhombohedral"),
+	N_("Hexagonal"),
+	N_("Simple cubic"),
+	N_("Body-centered cubic"),
+	N_("Face-centered cubic"),
+};
+
+
+} // namespace Elemental
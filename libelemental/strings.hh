@@ -0,0 +1,113 @@
+//! \file strings.hh
+//! Fixed translatable strings of libelemental.
+/*
+ * This file is part of libelemental, a periodic table library with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBELEMENTAL__STRINGS_HH
+#define LIBELEMENTAL__STRINGS_HH
+
+#include <libelemental/context.hh>
+
+namespace Elemental {
+
+/* The identifiers double as indices into each Context's table of translations,
+ * ahead of the identifiers assigned to the messages of properties and element
+ * data at initialization. */
+enum LibraryString
+{
+// Formats
+
+	S_ENTRY_NAME,
+	S_PROPERTIES_HEADER,
+	S_TIP,
+	S_LIST_SEPARATOR,
+	S_MARKUP_ERROR,
+
+// Qualifiers
+
+	S_UNKNOWN,
+	S_NOT_APPLICABLE,
+	S_ESTIMATED,
+	S_APPROXIMATE,
+	S_ISOTOPE,
+	S_INEXACT,
+	S_ESTIMATED_TIP,
+	S_APPROXIMATE_TIP,
+	S_ISOTOPE_TIP,
+
+// Event
+
+	S_UNDISCOVERED,
+	S_ANCIENT,
+
+// Series
+
+	S_NONMETALS,
+	S_NOBLE_GASES,
+	S_ALKALI_METALS,
+	S_ALKALINE_EARTH_METALS,
+	S_SEMIMETALS,
+	S_HALOGENS,
+	S_POST_TRANSITION_METALS,
+	S_TRANSITION_METALS,
+	S_LANTHANIDES,
+	S_ACTINIDES,
+
+// Block
+
+	S_S_BLOCK,
+	S_P_BLOCK,
+	S_D_BLOCK,
+	S_F_BLOCK,
+
+// Phase
+
+	S_SOLID,
+	S_LIQUID,
+	S_GAS,
+
+// LatticeType
+
+	S_TRICLINIC,
+	S_MONOCLINIC,
+	S_ORTHORHOMBIC,
+	S_TETRAGONAL,
+	S_RHOMBOHEDRAL,
+	S_HEXAGONAL,
+	S_SIMPLE_CUBIC,
+	S_BODY_CENTERED_CUBIC,
+	S_FACE_CENTERED_CUBIC,
+
+	S_COUNT
+};
+
+//! The untranslated library strings, indexed by LibraryString.
+extern const char* const library_strings[S_COUNT];
+
+//! Returns a library string translated in the current context.
+inline const char*
+translate (LibraryString id) throw ()
+{
+	return Context::get_current ().translate (id, library_strings[id]);
+}
+
+} // namespace Elemental
+
+#endif // LIBELEMENTAL__STRINGS_HH
@@ -23,61 +23,64 @@
 #include <libelemental/data.hh>
 #include <libelemental/table.hh>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+
 namespace Elemental {
 
 
-static Table table;
+//******************************************************************************
+// class Dataset
 
 
-void
-initialize () throw ()
+Dataset::Dataset (const ElementData source[], unsigned int count, bool copy)
+	throw ()
+:	scales (FloatProperty::scale_count)
 {
-	static bool initialized = false;
-	if (initialized) return;
-
-	initialized = true;
+	if (copy)
+	{
+		data.assign (source, source + count);
+		source = &data.front ();
+	}
 
-	bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
-	bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+	table.reserve (count);
+	for (unsigned int i = 0; i < count; ++i)
+		table.push_back (new Element (source[i]));
 
-	for (unsigned int i = 0; i < table_length; ++i)
-		table.push_back (new Element (table_data[i]));
-	
 	FOREACH (std::list<Category*>, CATEGORIES, category)
 		FOREACH (std::list<PropertyBase*>, (*category)->properties, prop)
-		{
-			EntriesView::accommodate_name
-				(compose::ucompose (_("%1:"), (*prop)->get_name ()).size ());
-
 			if cast (*prop, FloatProperty, float_prop)
 				FOREACH (Table, table, el)
-					float_prop->process_value
+					scales[float_prop->scale_index].process_value
 						((*el)->get_property (*float_prop));
-		}
+}
+
+
+Dataset::~Dataset ()
+{
+	FOREACH (Table, table, el)
+		delete *el;
 }
 
 
 const Table&
-get_table () throw ()
+Dataset::get_table () const throw ()
 {
-	initialize ();
 	return table;
 }
 
 
 const Element&
-get_element (AtomicNumber number)
+Dataset::get_element (AtomicNumber number) const
 {
-	initialize ();
 	return *table.at (number - 1);
 }
 
 
 const Element&
-get_element (const std::string& which)
+Dataset::get_element (const std::string& which) const
 {
-	initialize ();
-
 	try
 	{
 		if (Glib::Unicode::isdigit (which.at (0)))
@@ -94,6 +97,184 @@ get_element (const std::string& which)
 }
 
 
+const Property<Float>::Scale&
+Dataset::get_scale (const FloatProperty& property) const throw ()
+{
+	return scales[property.scale_index];
+}
+
+
+//******************************************************************************
+// current dataset
+
+
+// The owning pointer is read and written with the atomic shared_ptr functions.
+// Unpinned readers hold a pin of their own in a thread-local slot, which they
+// renew only when the generation shows that a new dataset has been published;
+// a replaced dataset is freed once every pin on it, including those of each
+// thread's slot, has been released.
+static Dataset::Ptr current_owner;
+static std::atomic<unsigned long> generation (0); // zero until initialized
+static std::mutex publishing;
+
+struct ReaderPin
+{
+	unsigned long generation;
+	Dataset::Ptr dataset;
+};
+
+static thread_local ReaderPin reader = { 0, Dataset::Ptr () };
+
+
+// Once the slot is current, readers make a single acquire load, which is an
+// ordinary load on common architectures.
+static inline const Dataset&
+get_current () throw ()
+{
+	unsigned long latest = generation.load (std::memory_order_acquire);
+	if (latest != reader.generation || latest == 0)
+	{
+		if (latest == 0)
+		{
+			initialize ();
+			latest = generation.load (std::memory_order_acquire);
+		}
+		// A dataset published meanwhile only makes the next call renew again.
+		reader.dataset = std::atomic_load (&current_owner);
+		reader.generation = latest;
+	}
+	return *reader.dataset;
+}
+
+
+Dataset::Ptr
+get_dataset () throw ()
+{
+	initialize ();
+	return std::atomic_load (&current_owner);
+}
+
+
+void
+publish_dataset (const Dataset::Ptr& dataset)
+{
+	if (!dataset) throw std::invalid_argument ("empty dataset");
+	initialize ();
+
+	std::lock_guard<std::mutex> lock (publishing);
+	std::atomic_store (&current_owner, dataset);
+	generation.fetch_add (1, std::memory_order_release);
+}
+
+
+//******************************************************************************
+// class DatasetBuilder
+
+
+DatasetBuilder::DatasetBuilder ()
+{
+	const Dataset &base = get_current ();
+	data.reserve (base.table.size ());
+	CONST_FOREACH (Table, base.table, el)
+		data.push_back ((*el)->data);
+}
+
+
+DatasetBuilder::DatasetBuilder (const Dataset& base)
+{
+	data.reserve (base.table.size ());
+	CONST_FOREACH (Table, base.table, el)
+		data.push_back ((*el)->data);
+}
+
+
+DatasetBuilder::~DatasetBuilder ()
+{}
+
+
+value_base&
+DatasetBuilder::get_value (AtomicNumber number, const PropertyBase& property)
+{
+	value_base *value = Element::get_stored (data.at (number - 1), property);
+	if (value == NULL)
+		throw std::invalid_argument ("not a stored value property");
+	return *value;
+}
+
+
+Dataset::Ptr
+DatasetBuilder::build () const
+{
+	return Dataset::Ptr (new Dataset (&data.front (), data.size (), true));
+}
+
+
+//******************************************************************************
+// table access
+
+
+void
+initialize () throw ()
+{
+	// The initial dataset and the string identifiers are written only here;
+	// call_once publishes them to every caller.
+	static std::once_flag initialized;
+
+	std::call_once (initialized, []
+	{
+		bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
+		bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+
+		Dataset::Ptr initial (new Dataset (table_data, table_length, false));
+
+		Context::assign_ids (initial->get_table ());
+		Context::load_global ();
+
+		std::atomic_store (&current_owner, initial);
+		generation.store (1, std::memory_order_release);
+	});
+}
+
+
+const Property<Float>::Scale&
+Property<Float>::get_scale () const throw ()
+{
+	return get_current ().get_scale (*this);
+}
+
+
+const Property<Float>::Scale&
+Property<Float>::get_scale (const Dataset& dataset) const throw ()
+{
+	return dataset.get_scale (*this);
+}
+
+
+const Table&
+get_table () throw ()
+{
+	return get_current ().get_table ();
+}
+
+
+const Element&
+get_element (AtomicNumber number)
+{
+	Stats::Timer timer (Stats::GET_ELEMENT);
+
+	return get_current ().get_element (number);
+}
+
+
+const Element&
+get_element (const std::string& which)
+{
+	Stats::Timer timer (Stats::GET_ELEMENT);
+
+	return get_current ().get_element (which);
+}
+
+
 //******************************************************************************
 // class Tango
 
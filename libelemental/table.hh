@@ -28,6 +28,7 @@
 #include <libelemental/value-types.hh>
 #include <libelemental/element.hh>
 
+#include <memory>
 #include <stdexcept>
 
 //******************************************************************************
@@ -37,26 +38,156 @@ namespace Elemental {
 //! The periodic table of elements.
 typedef std::vector<const Element*> Table;
 
+//******************************************************************************
+
+//! An immutable version of the element data.
+/*! The library always has one current dataset, which get_table() and the
+ * get_element() functions read. It may be replaced at runtime with
+ * publish_dataset(). A pinned dataset, as returned by get_dataset(), and its
+ * elements remain valid for as long as the pin is held, however many datasets
+ * are published meanwhile. */
+class Dataset
+{
+public:
+
+	//! A pin on a dataset.
+	typedef std::shared_ptr<const Dataset> Ptr;
+
+	~Dataset ();
+
+	//! Returns the periodic table of elements in this dataset.
+	const Table& get_table () const throw ();
+
+	//! Returns the element with a given atomic number.
+	/*! \param number The atomic number of an element.
+	 * \return A reference to the corresponding element.
+	 * \throw std::out_of_range if the atomic number is invalid. */
+	const Element& get_element (AtomicNumber number) const;
+
+	//! Returns the element with a given symbol or atomic number.
+	/*! \param which The standard symbol of an element, or the string
+	 * representation of the atomic number of an element.
+	 * \return A reference to the corresponding element.
+	 * \throw std::invalid_argument if the symbol or number is invalid. */
+	const Element& get_element (const std::string& which) const;
+
+private:
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend void initialize () throw ();
+	friend class DatasetBuilder;
+	friend class Property<Float>;
+#endif
+
+	Dataset (const ElementData source[], unsigned int count, bool copy)
+		throw ();
+
+	Dataset (const Dataset&);
+	Dataset& operator= (const Dataset&);
+
+	const Property<Float>::Scale& get_scale (const FloatProperty& property)
+		const throw ();
+
+	std::vector<ElementData> data;
+	Table table;
+	std::vector<Property<Float>::Scale> scales;
+};
+
+//******************************************************************************
+
+//! A modifiable copy of a dataset's values, for building a new dataset.
+class DatasetBuilder
+{
+public:
+
+	//! Constructs a new builder from the values of the current dataset.
+	DatasetBuilder ();
+
+	//! Constructs a new builder from the values of a given dataset.
+	//! \param base The dataset to be copied.
+	explicit DatasetBuilder (const Dataset& base);
+
+	~DatasetBuilder ();
+
+	//! Replaces the value of a property for an element.
+	/*! Only stored values can be replaced; values calculated from other
+	 * properties are recalculated when the dataset is built.
+	 * \param number The atomic number of an element.
+	 * \param property The Element Property to be replaced.
+	 * \param value The new value.
+	 * \throw std::out_of_range if the atomic number is invalid.
+	 * \throw std::invalid_argument if the property is not a stored value. */
+	template<class T> void set (AtomicNumber number,
+		const Property<T>& property, const T& value);
+
+	//! Builds a new dataset from the values in the builder.
+	//! The builder may be modified further and built again afterwards.
+	Dataset::Ptr build () const;
+
+private:
+
+	DatasetBuilder (const DatasetBuilder&);
+	DatasetBuilder& operator= (const DatasetBuilder&);
+
+	value_base& get_value (AtomicNumber number, const PropertyBase& property);
+
+	std::vector<ElementData> data;
+};
+
+template<class T>
+inline void
+DatasetBuilder::set (AtomicNumber number, const Property<T>& property,
+	const T& value)
+{
+	dynamic_cast<T&> (get_value (number, property)) = value;
+}
+
+//******************************************************************************
+
+//! Returns the current dataset, pinned for as long as the result is held.
+Dataset::Ptr get_dataset () throw ();
+
+//! Replaces the current dataset.
+/*! Readers holding a pin on the replaced dataset are unaffected. Each thread
+ * that reached it through get_table() or get_element(), which do not pin, may
+ * go on using it until that thread next calls one of those functions, or
+ * another which reads the current dataset. The replaced dataset is freed once
+ * no pins and no such thread remain. Calls to this function are serialized
+ * against each other but never block readers.
+ * \param dataset The new current dataset.
+ * \throw std::invalid_argument if \p dataset is empty. */
+void publish_dataset (const Dataset::Ptr& dataset);
+
+//******************************************************************************
+
 //! Initializes libelemental.
-/*! This function may be called more than once. This function, or one of the
- * get_table() or get_element() functions, which call it, should be called
- * before any other features in the library are used. */
+/*! This function may be called more than once, and from any thread; only the
+ * first call has any effect, and concurrent first calls wait for it to finish.
+ * This function, or one of the get_table() or get_element() functions, which
+ * call it, should be called before any other features in the library are used.
+ * Once it has returned, the table and its elements may be read concurrently
+ * from any number of threads without locking. */
 void initialize () throw ();
 
-//! Returns the periodic table of elements.
-//! The table is a singleton.
+//! Returns the periodic table of elements in the current dataset.
+/*! The result is not pinned; once the dataset is replaced, it remains valid
+ * until the calling thread next reads the current dataset, as through this
+ * function or get_element(). Use get_dataset() to hold on to it for longer. */
 const Table& get_table () throw ();
 
-//! Returns the element with a given atomic number.
+//! Returns the element with a given atomic number in the current dataset.
 /*! \param number The atomic number of an element.
- * \return A reference to the corresponding element.
+ * \return A reference to the corresponding element, which remains valid as
+ * the result of get_table() does.
  * \throw std::out_of_range if the atomic number is invalid. */
 const Element& get_element (AtomicNumber number);
 
-//! Returns the element with a given symbol or atomic number.
+//! Returns the element with a given symbol or atomic number in the current
+//! dataset.
 /*! \param which The standard symbol of an element, or the string representation
  * of the atomic number of an element.
- * \return A reference to the corresponding element.
+ * \return A reference to the corresponding element, which remains valid as
+ * the result of get_table() does.
  * \throw std::invalid_argument if the symbol or number is invalid. */
 const Element& get_element (const std::string& which);
 
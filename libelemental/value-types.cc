@@ -20,9 +20,12 @@
  */
 
 #include "private.hh"
+#include "strings.hh"
 #include <libelemental/value-types.hh>
 
-#include <glibmm/date.h>
+#include <ctime>
+#include <locale>
+#include <sstream>
 
 namespace Elemental {
 
@@ -32,12 +35,12 @@ namespace Elemental {
 
 
 Message::Message (const char* source, Qualifier qualifier_) throw ()
-:	value_base (qualifier_), value (source)
+:	value_base (qualifier_), value (source), id (Context::NO_ID)
 {}
 
 
 Message::Message (Qualifier qualifier_) throw ()
-:	value_base (qualifier_)
+:	value_base (qualifier_), id (Context::NO_ID)
 {}
 
 
@@ -48,6 +51,8 @@ Message::~Message ()
 int
 Message::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 	
@@ -62,12 +67,13 @@ Message::compare (const value_base& other) const throw ()
 ustring
 Message::get_string (const ustring& format) const throw ()
 {
+	Stats::Timer timer (Stats::GET_STRING);
+
 	switch (qualifier)
 	{
 	case Q_EST:
 	case Q_CA:
-		// Translators: "(?) %1" prefixes a string indicating an inexact value.
-		return compose::ucompose (_("(?) %1"), do_get_string (format));
+		return compose::ucompose (translate (S_INEXACT), do_get_string (format));
 	default:
 		return value_base::get_string (format);
 	}
@@ -77,7 +83,7 @@ Message::get_string (const ustring& format) const throw ()
 ustring
 Message::do_get_string (const ustring& format) const throw ()
 {
-	ustring result = _(value.data ());
+	ustring result = Context::get_current ().translate (id, value.data ());
 	return format.empty () ? result : compose::ucompose (format, result);
 }
 
@@ -87,14 +93,15 @@ Message::do_get_string (const ustring& format) const throw ()
 
 
 Event::Event (int when_, const ustring& where_, Qualifier qualifier_) throw ()
-:	value_base (qualifier_), when (when_), where (where_)
+:	value_base (qualifier_), when (when_), where (where_),
+	where_id (Context::NO_ID)
 {
 	always = true;
 }
 
 
 Event::Event (Qualifier qualifier_) throw ()
-:	value_base (qualifier_)
+:	value_base (qualifier_), where_id (Context::NO_ID)
 {
 	always = true;
 }
@@ -106,6 +113,8 @@ Event::~Event ()
 int
 Event::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -126,23 +135,37 @@ Event::compare (const value_base& other) const throw ()
 ustring
 Event::get_string (const ustring& format) const throw ()
 {
+	Stats::Timer timer (Stats::GET_STRING);
+
 	switch (qualifier)
 	{
-	case Q_UNK: return _("Undiscovered");
-	case Q_NA: return _("Known to the ancients");
+	case Q_UNK: return translate (S_UNDISCOVERED);
+	case Q_NA: return translate (S_ANCIENT);
 	case Q_NEUTRAL:
 	default:
-		return do_get_string (format.empty () ? _("%1 (%2)") : format);
+		return do_get_string (format.empty () ? translate (S_TIP) : format);
 	}
 }
 
 
+// The year is formatted as by strftime's %Y in the context's locale, so that
+// it takes the context's digits but no digit grouping.
 ustring
 Event::do_get_string (const ustring& format) const throw ()
 {
-	return compose::ucompose (format,
-		Glib::Date (1, Glib::Date::JANUARY, when).format_string ("%Y"),
-		_(where.data ()));
+	const Context &context = Context::get_current ();
+
+	std::tm date = std::tm ();
+	date.tm_year = when - 1900;
+	date.tm_mday = 1;
+
+	std::ostringstream year;
+	year.imbue (context.get_locale ());
+	std::use_facet<std::time_put<char> > (year.getloc ()).put
+		(std::ostreambuf_iterator<char> (year), year, ' ', &date, 'Y');
+
+	return compose::ucompose (format, year.str (),
+		context.translate (where_id, where.data ()));
 }
 
 
@@ -192,6 +215,8 @@ Series::~Series ()
 int
 Series::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -244,30 +269,30 @@ Series::get_color () const throw ()
 ustring
 Series::do_get_string (const ustring& format) const throw ()
 {
-	ustring result = _("(unknown)");
+	ustring result = translate (S_UNKNOWN);
 
 	switch (value)
 	{
 	case NONMETAL:
-		result = _("Nonmetals"); break;
+		result = translate (S_NONMETALS); break;
 	case NOBLE_GAS:
-		result = _("Noble gases"); break;
+		result = translate (S_NOBLE_GASES); break;
 	case ALKALI_METAL:
-		result = _("Alkali metals"); break;
+		result = translate (S_ALKALI_METALS); break;
 	case ALKALINE_EARTH_METAL:
-		result = _("Alkaline earth metals"); break;
+		result = translate (S_ALKALINE_EARTH_METALS); break;
 	case SEMIMETAL:
-		result = _("Semimetals"); break;
+		result = translate (S_SEMIMETALS); break;
 	case HALOGEN:
-		result = _("Halogens"); break;
+		result = translate (S_HALOGENS); break;
 	case POST_TRANSITION_METAL:
-		result = _("Post-transition metals"); break;
+		result = translate (S_POST_TRANSITION_METALS); break;
 	case TRANSITION_METAL:
-		result = _("Transition metals"); break;
+		result = translate (S_TRANSITION_METALS); break;
 	case LANTHANIDE:
-		result = _("Lanthanides"); break;
+		result = translate (S_LANTHANIDES); break;
 	case ACTINIDE:
-		result = _("Actinides"); break;
+		result = translate (S_ACTINIDES); break;
 	}
 
 	return format.empty () ? result : compose::ucompose (format, result);
@@ -295,6 +320,8 @@ Block::~Block ()
 int
 Block::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -331,14 +358,14 @@ Block::get_color () const throw ()
 ustring
 Block::do_get_string (const ustring& format) const throw ()
 {
-	ustring result = _("(unknown)");
+	ustring result = translate (S_UNKNOWN);
 
 	switch (value)
 	{
-	case S: result = _("s-block"); break;
-	case P: result = _("p-block"); break;
-	case D: result = _("d-block"); break;
-	case F: result = _("f-block"); break;
+	case S: result = translate (S_S_BLOCK); break;
+	case P: result = translate (S_P_BLOCK); break;
+	case D: result = translate (S_D_BLOCK); break;
+	case F: result = translate (S_F_BLOCK); break;
 	}
 
 	return format.empty () ? result : compose::ucompose (format, result);
@@ -366,6 +393,8 @@ Phase::~Phase ()
 int
 Phase::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -404,16 +433,16 @@ Phase::get_color () const throw ()
 ustring
 Phase::do_get_string (const ustring& format) const throw ()
 {
-	ustring result = _("(unknown)");
+	ustring result = translate (S_UNKNOWN);
 
 	switch (value)
 	{
 	case SOLID:
-		result = _("Solid"); break;
+		result = translate (S_SOLID); break;
 	case LIQUID:
-		result = _("Liquid"); break;
+		result = translate (S_LIQUID); break;
 	case GAS:
-		result = _("Gas"); break;
+		result = translate (S_GAS); break;
 	}
 
 	return format.empty () ? result : compose::ucompose (format, result);
@@ -441,6 +470,8 @@ LatticeType::~LatticeType ()
 int
 LatticeType::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -489,28 +520,28 @@ LatticeType::get_color () const throw ()
 ustring
 LatticeType::do_get_string (const ustring& format) const throw ()
 {
-	ustring result = _("(unknown)");
+	ustring result = translate (S_UNKNOWN);
 
 	switch (value)
 	{
 	case TRI:
-		result = _("Triclinic"); break;
+		result = translate (S_TRICLINIC); break;
 	case MONO:
-		result = _("Monoclinic"); break;
+		result = translate (S_MONOCLINIC); break;
 	case ORTH:
-		result = _("Orthorhombic"); break;
+		result = translate (S_ORTHORHOMBIC); break;
 	case TET:
-		result = _("Tetragonal"); break;		
+		result = translate (S_TETRAGONAL); break;		
 	case RHO:
-		result = _("Rhombohedral"); break;
+		result = translate (S_RHOMBOHEDRAL); break;
 	case HEX:
-		result = _("Hexagonal"); break;
+		result = translate (S_HEXAGONAL); break;
 	case SC:
-		result = _("Simple cubic"); break;
+		result = translate (S_SIMPLE_CUBIC); break;
 	case BCC:
-		result = _("Body-centered cubic"); break;
+		result = translate (S_BODY_CENTERED_CUBIC); break;
 	case FCC:
-		result = _("Face-centered cubic"); break;
+		result = translate (S_FACE_CENTERED_CUBIC); break;
 	}
 
 	return format.empty () ? result : compose::ucompose (format, result);
@@ -544,6 +575,8 @@ ColorValue::~ColorValue ()
 int
 ColorValue::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 
@@ -70,12 +70,22 @@ public:
 	virtual ustring get_string (const ustring& format = ustring ()) const
 		throw ();
 
+	using value_base::get_string;
+
 	//! The untranslated message, if defined.
 	ustring value;
 
 protected:
 
 	virtual ustring do_get_string (const ustring& format) const throw ();
+
+private:
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend class Context;
+#endif
+
+	mutable unsigned int id;
 };
 
 //******************************************************************************
@@ -109,6 +119,8 @@ public:
 	 * \return A UTF-8 string containing the localized representation. */
 	virtual ustring get_string (const ustring& format = ustring ()) const
 		throw ();
+
+	using value_base::get_string;
 	
 	//! The year in which the event occurred, if defined.
 	int when;
@@ -122,6 +134,14 @@ protected:
 
 	//! Compares the qualifications of two events.
 	virtual int compare_base (const value_base& other) const throw ();
+
+private:
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	friend class Context;
+#endif
+
+	mutable unsigned int where_id;
 };
 
 //******************************************************************************
@@ -160,6 +180,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	virtual color get_color () const throw ();
 	
 	//! The value, if defined.
@@ -200,6 +222,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	virtual color get_color () const throw ();
 
 	//! The value, if defined.
@@ -239,6 +263,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	virtual color get_color () const throw ();
 
 	//! The value, if defined.
@@ -284,6 +310,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	virtual color get_color () const throw ();
 
 	//! The value, if defined.
@@ -322,6 +350,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	virtual color get_color () const throw ();
 
 	//! The display color, if defined.
@@ -20,12 +20,12 @@
  */
 
 #include "private.hh"
+#include "strings.hh"
 #include <libelemental/value.hh>
 #include <libelemental/value-types.hh>
 
 #include <ext/stdio_filebuf.h>
-#include <glibmm/utility.h>
-#include <pango/pango.h>
+#include <glibmm/convert.h>
 
 namespace Elemental {
 
@@ -36,9 +36,7 @@ const double STANDARD_TEMPERATURE = 273.15; // Kelvin
 ustring
 get_list_separator () throw ()
 {
-	// Translators: This is the separator for items in a list.
-	static const Message LIST_SEPARATOR = N_(", ");
-	return LIST_SEPARATOR.get_string ();
+	return translate (S_LIST_SEPARATOR);
 }
 
 
@@ -111,22 +109,10 @@ EntriesView::~EntriesView ()
 ustring::size_type
 EntriesView::get_max_name_length () throw ()
 {
-	return max_name_length;
+	return Context::get_current ().get_max_name_length ();
 }
 
 
-void
-EntriesView::accommodate_name (ustring::size_type length) throw ()
-{
-	if (length > max_name_length)
-		max_name_length = length;
-}
-
-
-ustring::size_type
-EntriesView::max_name_length = 0;
-
-
 //******************************************************************************
 // class EntriesStream
 
@@ -134,38 +120,137 @@ EntriesView::max_name_length = 0;
 EntriesStream::EntriesStream (FILE* file) throw ()
 :	buf (new __gnu_cxx::stdio_filebuf<char> (file, std::ios_base::out)),
 	buf_owned (true), os (*new std::ostream (buf)), os_owned (true)
-{}
+{
+	init ();
+}
 
 
 EntriesStream::EntriesStream (int fd) throw ()
 :	buf (new __gnu_cxx::stdio_filebuf<char> (fd, std::ios_base::out)),
 	buf_owned (true), os (*new std::ostream (buf)), os_owned (true)
-{}
+{
+	init ();
+}
 
 
 EntriesStream::EntriesStream (std::streambuf& buf_) throw ()
 :	buf (&buf_), buf_owned (false),
 	os (*new std::ostream (buf)), os_owned (true)
-{}
+{
+	init ();
+}
 
 
 EntriesStream::EntriesStream (std::ostream& os_) throw ()
 :	buf (NULL), buf_owned (false),
 	os (os_), os_owned (false)
-{}
+{
+	init ();
+}
 
 
 EntriesStream::~EntriesStream ()
 {
+	flush ();
 	if (os_owned) delete &os;
 	if (buf_owned) delete buf;
 }
 
 
+// The buffer is written out once it reaches this size.
+static const std::string::size_type ENTRIES_STREAM_BUFFER = 64 * 1024;
+
+
+void
+EntriesStream::init () throw ()
+{
+	buffer.reserve (ENTRIES_STREAM_BUFFER + 1024);
+	convert = !Glib::get_charset (charset);
+}
+
+
 void
 EntriesStream::header (const ustring& category) throw ()
 {
-	os << std::endl << category << std::endl;
+	buffer += '\n';
+	buffer += category.raw ();
+	buffer += '\n';
+
+	if (buffer.size () >= ENTRIES_STREAM_BUFFER)
+		flush ();
+}
+
+
+bool
+append_unmarked (std::string& dest, const std::string& src) throw ()
+{
+	std::string::size_type pos = 0, length = src.size ();
+
+	while (pos < length)
+	{
+		std::string::size_type special = src.find_first_of ("<&", pos);
+		if (special == std::string::npos)
+		{
+			dest.append (src, pos, std::string::npos);
+			break;
+		}
+
+		dest.append (src, pos, special - pos);
+
+		if (src[special] == '<')
+		{
+			std::string::size_type close = src.find ('>', special);
+			if (close == std::string::npos) return false;
+			pos = close + 1;
+			continue;
+		}
+
+		// An entity is a name or a character reference, which must be
+		// followed immediately by a semicolon.
+		std::string::size_type begin = special + 1, end = begin;
+		if (end < length && src[end] == '#') ++end;
+		while (end < length && g_ascii_isalnum (src[end])) ++end;
+		if (end == length || src[end] != ';') return false;
+		pos = end + 1;
+
+		const char *entity = src.data () + begin;
+		std::string::size_type entity_length = end - begin;
+
+		if (entity_length > 0 && entity[0] == '#')
+		{
+			bool hex = entity_length > 1 &&
+				(entity[1] == 'x' || entity[1] == 'X');
+			std::string::size_type first = hex ? 2 : 1;
+			if (entity_length == first) return false;
+
+			gunichar ch = 0;
+			for (std::string::size_type i = first; i < entity_length; ++i)
+			{
+				int digit = hex ? g_ascii_xdigit_value (entity[i])
+					: g_ascii_digit_value (entity[i]);
+				if (digit < 0 || ch > 0x10FFFF) return false;
+				ch = ch * (hex ? 16 : 10) + digit;
+			}
+			if (ch == 0 || !g_unichar_validate (ch)) return false;
+
+			gchar utf8[6];
+			dest.append (utf8, g_unichar_to_utf8 (ch, utf8));
+		}
+		else if (src.compare (begin, entity_length, "amp") == 0)
+			dest += '&';
+		else if (src.compare (begin, entity_length, "lt") == 0)
+			dest += '<';
+		else if (src.compare (begin, entity_length, "gt") == 0)
+			dest += '>';
+		else if (src.compare (begin, entity_length, "quot") == 0)
+			dest += '"';
+		else if (src.compare (begin, entity_length, "apos") == 0)
+			dest += '\'';
+		else
+			return false;
+	}
+
+	return true;
 }
 
 
@@ -173,41 +258,59 @@ void
 EntriesStream::entry (const ustring& name, const ustring& value,
 	const ustring& tip) throw ()
 {
-	ustring result = "  ";
+	Stats::Timer timer (Stats::WRITE_ENTRY);
+
+	std::string::size_type line = buffer.size ();
+	buffer += "  ";
 
 	if (!name.empty ())
 	{
-		result += name;
+		buffer += name.raw ();
 
 		ustring::size_type padding =
 			std::max (0, int (get_max_name_length ()) - int (name.size ())) + 1;
-		result += ustring (padding, ' ');
+		buffer.append (padding, ' ');
 	}
 
+	bool parsed;
+	if (tip.empty ())
+		parsed = append_unmarked (buffer, value.raw ());
+	else
 	{
-		Glib::ScopedPtr<char> parsed_value;
-		GError *error = NULL;
-		if (!pango_parse_markup (value.data (), -1, 0, NULL,
-			parsed_value.addr (), NULL, &error))
-		{
-			os << Glib::Error (error).what () << std::endl;
-			return;
-		}
+		std::string unmarked;
+		parsed = append_unmarked (unmarked, value.raw ());
+		if (parsed)
+			buffer += compose::ucompose
+				(translate (S_TIP), unmarked, tip).raw ();
+	}
 
-		result += tip.empty () ? parsed_value.get ()
-			: compose::ucompose (_("%1 (%2)"), parsed_value.get (), tip);
+	// Malformed markup is reported in place of the entry.
+	if (!parsed)
+	{
+		buffer.resize (line);
+		buffer += compose::ucompose (translate (S_MARKUP_ERROR), value).raw ();
 	}
 
-	if (Glib::get_charset ())
-		os << result;
-	else
+	buffer += '\n';
+
+	if (buffer.size () >= ENTRIES_STREAM_BUFFER)
+		flush ();
+}
+
+
+void
+EntriesStream::flush () throw ()
+{
+	if (!buffer.empty ())
 	{
-		std::string charset;
-		Glib::get_charset (charset);
-		os << Glib::convert_with_fallback (result, charset, "UTF-8", "?");
+		if (convert)
+			os << Glib::convert_with_fallback (buffer, charset, "UTF-8", "?");
+		else
+			os.write (buffer.data (), buffer.size ());
+		buffer.clear ();
 	}
-		
-	os << std::endl;
+
+	os.flush ();
 }
 
 
@@ -248,16 +351,15 @@ value_base::has_value () const throw ()
 ustring
 value_base::get_string (const ustring& format) const throw ()
 {
+	Stats::Timer timer (Stats::GET_STRING);
+
 	switch (qualifier)
 	{
-	case Q_UNK: return _("(unknown)");
-	case Q_NA: return _("(n/a)");
-	// Translators: "(%1)" represents an estimated or calculated value.
-	case Q_EST: return compose::ucompose (_("(%1)"), do_get_string (format));
-	// Translators: "~%1" represents an approximate value.
-	case Q_CA: return compose::ucompose (_("~%1"), do_get_string (format));
-	// Translators: "[%1]" represents a value for a most stable isotope.
-	case Q_ISO: return compose::ucompose (_("[%1]"), do_get_string (format));
+	case Q_UNK: return translate (S_UNKNOWN);
+	case Q_NA: return translate (S_NOT_APPLICABLE);
+	case Q_EST: return compose::ucompose (translate (S_ESTIMATED), do_get_string (format));
+	case Q_CA: return compose::ucompose (translate (S_APPROXIMATE), do_get_string (format));
+	case Q_ISO: return compose::ucompose (translate (S_ISOTOPE), do_get_string (format));
 	case Q_NEUTRAL:
 	default:
 		return do_get_string (format);
@@ -265,19 +367,36 @@ value_base::get_string (const ustring& format) const throw ()
 }
 
 
+ustring
+value_base::get_string (const Context& context, const ustring& format) const
+	throw ()
+{
+	Context::Scope scope (context);
+	return get_string (format);
+}
+
+
 ustring
 value_base::get_tip () const throw ()
 {
 	switch (qualifier)
 	{
-	case Q_EST: return _("Estimated or calculated value");
-	case Q_CA: return _("Approximate");
-	case Q_ISO: return _("Value for most stable isotope");
+	case Q_EST: return translate (S_ESTIMATED_TIP);
+	case Q_CA: return translate (S_APPROXIMATE_TIP);
+	case Q_ISO: return translate (S_ISOTOPE_TIP);
 	default: return ustring ();
 	}
 }
 
 
+ustring
+value_base::get_tip (const Context& context) const throw ()
+{
+	Context::Scope scope (context);
+	return get_tip ();
+}
+
+
 void
 value_base::make_entry (EntriesView& view, const ustring& name,
 	const ustring& format) const throw ()
@@ -287,9 +406,20 @@ value_base::make_entry (EntriesView& view, const ustring& name,
 }
 
 
+void
+value_base::make_entry (const Context& context, EntriesView& view,
+	const ustring& name, const ustring& format) const throw ()
+{
+	Context::Scope scope (context);
+	make_entry (view, name, format);
+}
+
+
 int
 value_base::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	return (base == YIELD_COMPARE) ? 0 : base;
 }
@@ -26,6 +26,8 @@
 
 #include <libelemental/misc/ucompose.hh>
 #include <libelemental/misc/extras.hh>
+#include <libelemental/context.hh>
+#include <libelemental/stats.hh>
 
 #include <limits>
 #include <iomanip>
@@ -100,6 +102,12 @@ struct color
 
 //******************************************************************************
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class value_base;
+class PropertyBase;
+class Element;
+#endif
+
 //! An interface for the display of value entries.
 class EntriesView
 {
@@ -107,6 +115,16 @@ public:
 
 	virtual ~EntriesView ();
 
+	//! Begins the entries for an element.
+	/*! Called by Element::make_entries() when all of an element's entries are
+	 * generated. The default implementation does nothing.
+	 * \param element The element whose entries follow. */
+	virtual void element_begin (const Element& element) throw ();
+
+	//! Ends the entries for an element.
+	//! The default implementation does nothing.
+	virtual void element_end () throw ();
+
 	//! Displays a category header.
 	//! \param category The name of the category.
 	virtual void header (const ustring& category) throw () = 0;
@@ -118,26 +136,31 @@ public:
 	virtual void entry (const ustring& name, const ustring& value,
 		const ustring& tip = ustring ()) throw () = 0;
 
+	//! Displays the value of a property.
+	/*! Called by PropertyBase::make_entry(). Views which handle values by type
+	 * may override this function. The default implementation passes the
+	 * localized name and value of the property to entry(), if the value
+	 * should make an entry.
+	 * \param property The property whose value is given.
+	 * \param value The value of the property. */
+	virtual void property_entry (const PropertyBase& property,
+		const value_base& value) throw ();
+
 protected:
 
 	//! Returns the greatest expected length of an entry name.
-	//! This value is calculated from the lengths of translated property names.
+	/*! This value is calculated from the lengths of property names translated
+	 * in the current Context. */
 	static ustring::size_type get_max_name_length () throw ();
-
-private:
-
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-	friend void initialize () throw ();
-#endif
-
-	static void accommodate_name (ustring::size_type length) throw ();
-	
-	static ustring::size_type max_name_length;
 };
 
 //******************************************************************************
 
 //! An adapter for the display of value entries on an output stream.
+/*! Output is collected in a buffer and written to the stream when the buffer
+ * fills, when flush() is called, and when the EntriesStream is destroyed.
+ * Values are stripped of Pango markup and converted to the locale's character
+ * set, which is determined once, on construction. */
 class EntriesStream
 :	public EntriesView
 {
@@ -155,6 +178,7 @@ public:
 	//! Constructs a new EntriesStream for an output stream.
 	EntriesStream (std::ostream& os) throw ();
 	
+	//! Flushes any buffered output and destroys the EntriesStream.
 	virtual ~EntriesStream ();
 
 	virtual void header (const ustring& category) throw ();
@@ -162,13 +186,22 @@ public:
 	virtual void entry (const ustring& name, const ustring& value,
 		const ustring& tip = ustring ()) throw ();
 
+	//! Writes any buffered output to the stream and flushes the stream.
+	void flush () throw ();
+
 private:
 
+	void init () throw ();
+
 	std::streambuf *buf;
 	bool buf_owned;
 
 	std::ostream &os;
 	bool os_owned;
+
+	std::string buffer;
+	bool convert;
+	std::string charset;
 };
 
 //******************************************************************************
@@ -195,11 +228,23 @@ public:
 	virtual ustring get_string (const ustring& format = ustring ()) const
 		throw ();
 
+	//! Returns a text representation of the value localized for a context.
+	/*! \param context The Context in which to render the value.
+	 * \param format An optional compose-style format string, as for
+	 * get_string(const ustring&).
+	 * \return A UTF-8 string containing the localized representation. */
+	ustring get_string (const Context& context,
+		const ustring& format = ustring ()) const throw ();
+
 	//! Returns a localized message to be displayed as a tooltip.
 	/*! The message may also be displayed parenthetically to the value.
 	 * \return A UTF-8 string containing the tip text, if any. */
 	ustring get_tip () const throw ();
 
+	//! Returns a message to be displayed as a tooltip, localized for a context.
+	//! \param context The Context in which to render the tip.
+	ustring get_tip (const Context& context) const throw ();
+
 	//! Possibly adds the result of get_string() to an EntriesView.
 	/*! An entry will only be made if the value is defined or if \p always is
 	 * \c true.
@@ -209,6 +254,15 @@ public:
 	void make_entry (EntriesView& view, const ustring& name,
 		const ustring& format = ustring ()) const throw ();
 
+	//! Possibly adds a value localized for a context to an EntriesView.
+	/*! \param context The Context in which to render the value.
+	 * \param view The EntriesView to be populated.
+	 * \param name The name of the value to be passed.
+	 * \param format An optional compose-style format for get_string(). */
+	void make_entry (const Context& context, EntriesView& view,
+		const ustring& name, const ustring& format = ustring ()) const
+		throw ();
+
 	//! Compares two qualified values.
 	/*! Derived classes may override this function, first calling compare_base,
 	 * and use a dynamic_cast to check other.
@@ -266,6 +320,8 @@ public:
 
 	virtual ~color_value_base ();
 
+	using value_base::get_string;
+
 	//! Returns a color representing the value.
 	/*! Derived classes must implement this function, returning a color that
 	 * corresponds to the defined value. A special color should be returned if
@@ -309,6 +365,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	//! The value, if defined.
 	T value;
 
@@ -354,6 +412,8 @@ public:
 
 	virtual int compare (const value_base& other) const throw ();
 
+	using value_base::get_string;
+
 	//! The values, if defined.
 	mutable std::vector<T> values;
 
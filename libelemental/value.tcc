@@ -62,6 +62,8 @@ template<class T>
 int
 Value<T>::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 		
@@ -84,10 +86,12 @@ template<class T>
 ustring
 Value<T>::do_get_string (const ustring& format) const throw ()
 {
+	const std::locale &locale = Context::get_current ().get_locale ();
 	if (format.empty ())
-		return compose::ucompose1 (value, std::numeric_limits<T>::digits10);
+		return compose::ucompose1
+			(value, std::numeric_limits<T>::digits10, locale);
 	else
-		return compose::UComposition (format)
+		return compose::UComposition (format).imbue (locale)
 			.precision (std::numeric_limits<T>::digits10)
 			.arg (value).str ();
 }
@@ -133,6 +137,8 @@ template<class T>
 int
 ValueList<T>::compare (const value_base& other) const throw ()
 {
+	Stats::Timer timer (Stats::COMPARE);
+
 	int base = compare_base (other);
 	if (base != YIELD_COMPARE) return base;
 		
@@ -155,6 +161,7 @@ template<class T>
 ustring
 ValueList<T>::do_get_string (const ustring& format) const throw ()
 {
+	const std::locale &locale = Context::get_current ().get_locale ();
 	ustring result;
 	for (typename std::vector<T>::const_iterator i = values.begin ();
 		i != values.end (); ++i)
@@ -163,9 +170,9 @@ ValueList<T>::do_get_string (const ustring& format) const throw ()
 			result += get_list_separator ();
 		if (format.empty ())
 			result += compose::ucompose1
-				(*i, std::numeric_limits<T>::digits10);
+				(*i, std::numeric_limits<T>::digits10, locale);
 		else
-			result += compose::UComposition (format)
+			result += compose::UComposition (format).imbue (locale)
 				.precision (std::numeric_limits<T>::digits10)
 				.arg (*i).str ();
 	}
@@ -39,25 +39,25 @@ namespace gElemental {
 void
 ColorButton::set_color (const color_value_base& value)
 {
-	Gdk::Color color = allocate (value.get_color ());
+	set_color (value.get_color ());
+}
+
 
+void
+ColorButton::set_color (const color& bg)
+{
 	if (is_force_needed ())
-	{
-		RefPtr<Gtk::Style> style = Gtk::Style::create ();
-		style->set_bg (Gtk::STATE_NORMAL, color);
-		style->set_bg (Gtk::STATE_ACTIVE, color);
-		style->set_bg (Gtk::STATE_PRELIGHT, color);
-		set_style (style);
-	}
+		set_style (get_color_style (bg));
 	else
 	{
+		const Gdk::Color &color = allocate (bg);
 		modify_bg (Gtk::STATE_NORMAL, color);
 		modify_bg (Gtk::STATE_ACTIVE, color);
 		modify_bg (Gtk::STATE_PRELIGHT, color);
 	}
 
 	if (Gtk::Widget *child = get_child ())
-		set_fgcolor (*child, value);
+		set_fgcolor (*child, bg);
 }
 
 
@@ -81,7 +81,14 @@ ColorButton::unset_color ()
 void
 ColorButton::set_fgcolor (Gtk::Widget& child, const color_value_base& value)
 {
-	Gdk::Color compliment = allocate (value.get_color ().get_compliment ());
+	set_fgcolor (child, value.get_color ());
+}
+
+
+void
+ColorButton::set_fgcolor (Gtk::Widget& child, const color& bg)
+{
+	const Gdk::Color &compliment = allocate (bg.get_compliment ());
 
 	child.modify_fg (Gtk::STATE_NORMAL, compliment);
 	child.modify_fg (Gtk::STATE_ACTIVE, compliment);
@@ -209,9 +216,11 @@ ColorButton::is_force_needed ()
 // class ElementButton
 
 
-ElementButton::ElementButton (const Element& el_, Gtk::Tooltips& tips)
+ElementButton::ElementButton (const Dataset::Ptr& dataset_,
+	const Element& el_, Gtk::Tooltips& tips)
 :	el (el_), group (el.get_property (P_GROUP)),
-	period (el.get_property (P_PERIOD))
+	period (el.get_property (P_PERIOD)), applied_valid (false), colored (false),
+	dataset (dataset_)
 {
 	set_label (el.symbol);
 
@@ -257,41 +266,73 @@ ElementButton::get_y_pos () const
 void
 ElementButton::show_properties ()
 {
-	ElementDialog *dialog = new ElementDialog (el);
+	ElementDialog &dialog = ElementDialog::get (dataset, el);
 	if cast (get_toplevel (), Gtk::Window, top)
-		dialog->set_transient_for (*top);
-	dialog->present ();
+		dialog.set_transient_for (*top);
+	dialog.present ();
 }
 
 
-void
-ElementButton::set_color_by_property (const PropertyBase* property,
-	double temperature, bool logarithmic)
+bool
+ElementButton::get_color_by_property (const PropertyBase* property,
+	double temperature, bool logarithmic, color& result) const
 {
 	if (property == NULL)
-		unset_color ();
+		return false;
 
 	else if (property == &P_PHASE)
-		set_color (el.get_phase (temperature));
+		result = el.get_phase (temperature).get_color ();
 	
 	else if cast (property, const FloatProperty, float_prop)
 	{
 		const Float &float_value = el.get_property (*float_prop);
 	
-		if (float_value.has_value () && float_prop->is_scale_valid ())
-			set_color (ColorValue
-				(float_prop->get_scale_position (float_value, logarithmic)));
+		if (float_value.has_value () && float_prop->is_scale_valid (*dataset))
+			result = ColorValue (float_prop->get_scale_position
+				(*dataset, float_value, logarithmic)).get_color ();
 
 		else
-			set_color (ColorValue ());
+			result = ColorValue ().get_color ();
 	}
 	
 	else if cast (&el.get_property_base (*property),
 		const color_value_base, color_value)
-		set_color (*color_value);
+		result = color_value->get_color ();
 	
+	else
+		return false;
+
+	return true;
+}
+
+
+// Styles are only modified when the color changes, since each modification
+// makes the button resize and redraw. A change of style, such as to a new
+// theme, discards the last color applied, so that the next is applied anyway.
+bool
+ElementButton::set_color_by_property (const PropertyBase* property,
+	double temperature, bool logarithmic)
+{
+	color bg;
+	bool new_colored = get_color_by_property
+		(property, temperature, logarithmic, bg);
+
+	if (applied_valid && new_colored == colored && (!colored ||
+		(bg.red == applied.red && bg.green == applied.green &&
+		bg.blue == applied.blue)))
+		return false;
+
+	colored = new_colored;
+	applied = bg;
+
+	if (colored)
+		set_color (applied);
 	else
 		unset_color ();
+
+	// Set after the style changes made by applying the color itself.
+	applied_valid = true;
+	return true;
 }
 
 
@@ -303,33 +344,35 @@ ElementButton::on_clicked ()
 }
 
 
+void
+ElementButton::on_style_changed (const Glib::RefPtr<Gtk::Style>& previous)
+{
+	ColorButton::on_style_changed (previous);
+	applied_valid = false;
+}
+
+
 //******************************************************************************
 // class ElementIdentity
 
 
-ElementIdentity::ElementIdentity (const Element& el)
+ElementIdentity::ElementIdentity ()
+:	el (NULL), number (NULL), symbol (NULL)
 {
 	property_can_focus ().set_value (false);
 	set_focus_on_click (false);
 	set_size_request (-1, 50);
 
-	const ColorValue& color = el.get_property (P_COLOR);
-	set_color (color);
-
 	push_composite_child ();
 
 	Gtk::VBox *square = new Gtk::VBox (false, 6);
 	square->set_border_width (6);
 	add (*Gtk::manage (square));
 
-	Gtk::Label *number = new Gtk::Label ();
-	set_fgcolor (*number, color);
-	number->set_markup ("<b>" + compose::ucompose1 (el.number) + "</b>");
+	number = new Gtk::Label ();
 	square->pack_start (*Gtk::manage (number), Gtk::PACK_EXPAND_PADDING);
 
-	Gtk::Label *symbol = new Gtk::Label ();
-	set_fgcolor (*symbol, color);
-	symbol->set_markup ("<big><big><b>" + el.symbol + "</b></big></big>");
+	symbol = new Gtk::Label ();
 	square->pack_start (*Gtk::manage (symbol), Gtk::PACK_EXPAND_PADDING);
 	
 	pop_composite_child ();
@@ -337,6 +380,29 @@ ElementIdentity::ElementIdentity (const Element& el)
 }
 
 
+ElementIdentity::ElementIdentity (const Element& el_)
+:	ElementIdentity ()
+{
+	set_element (el_);
+}
+
+
+void
+ElementIdentity::set_element (const Element& el_)
+{
+	if (el == &el_) return;
+	el = &el_;
+
+	const ColorValue& color = el->get_property (P_COLOR);
+	set_color (color);
+	set_fgcolor (*number, color);
+	set_fgcolor (*symbol, color);
+
+	number->set_markup ("<b>" + compose::ucompose1 (el->number) + "</b>");
+	symbol->set_markup ("<big><big><b>" + el->symbol + "</b></big></big>");
+}
+
+
 //******************************************************************************
 // class LegendButton
 
@@ -23,6 +23,7 @@
 #define GELEMENTAL__BUTTONS_HH
 
 #include <libelemental/element.hh>
+#include <libelemental/table.hh>
 
 #include <gtkmm/button.h>
 #include <gtkmm/tooltips.h>
@@ -39,11 +40,13 @@ class ColorButton
 public:
 
 	void set_color (const color_value_base& value);
+	void set_color (const color& bg);
 	void unset_color ();
 
 protected:
 
 	void set_fgcolor (Gtk::Widget& child, const color_value_base& value);
+	void set_fgcolor (Gtk::Widget& child, const color& bg);
 	void unset_fgcolor (Gtk::Widget& child);
 
 private:
@@ -58,14 +61,17 @@ class ElementButton
 {
 public:
 
-	ElementButton (const Element& el, Gtk::Tooltips& tips);
+	ElementButton (const Dataset::Ptr& dataset, const Element& el,
+		Gtk::Tooltips& tips);
 
 	int get_x_pos () const;
 	int get_y_pos () const;
 
 	void show_properties ();
 
-	void set_color_by_property (const PropertyBase* property,
+	bool get_color_by_property (const PropertyBase* property,
+		double temperature, bool logarithmic, color& result) const;
+	bool set_color_by_property (const PropertyBase* property,
 		double temperature, bool logarithmic);
 
 	const Element &el;
@@ -73,8 +79,15 @@ public:
 private:
 
 	virtual void on_clicked ();
+	virtual void on_style_changed (const Glib::RefPtr<Gtk::Style>& previous);
 	
 	Int group, period;
+
+	// The color last applied, if any, until the style is next changed.
+	bool applied_valid, colored;
+	color applied;
+
+	Dataset::Ptr dataset;
 };
 
 //******************************************************************************
@@ -84,7 +97,15 @@ class ElementIdentity
 {
 public:
 
+	ElementIdentity ();
 	ElementIdentity (const Element& el);
+
+	void set_element (const Element& el);
+
+private:
+
+	const Element *el;
+	Gtk::Label *number, *symbol;
 };
 
 //******************************************************************************
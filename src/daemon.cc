@@ -0,0 +1,693 @@
+/*
+ * This file is part of gElemental, a periodic table viewer with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// elementald answers element queries over a Unix-domain socket. Each request
+// is one line of words separated by spaces:
+//
+//   ELEMENT <element> [<format> [<locale>]]
+//   PROPERTY <element> <key>[,<key>...] [<format> [<locale>]]
+//   PING
+//
+// The format is one of those of elemental-query; the locale is the name of an
+// installed locale, or "-" for the daemon's own. Each response is either
+// "OK <length>" and a newline followed by <length> bytes of output, or "ERR"
+// followed by a message and a newline.
+
+#include "private.hh"
+#include <libelemental/context.hh>
+#include <libelemental/formats.hh>
+#include <libelemental/table.hh>
+
+#include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <locale>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <glib.h>
+#include <glibmm/init.h>
+#include <glibmm/optioncontext.h>
+#include <glibmm/optionentry.h>
+#include <glibmm/optiongroup.h>
+
+using namespace Elemental;
+
+//******************************************************************************
+
+// A request line longer than this is refused and its connection closed.
+static const std::string::size_type MAX_REQUEST = 4096;
+
+// No more requests are read from a client while this much of its output is
+// waiting to be sent.
+static const std::string::size_type MAX_PENDING_OUTPUT = 1 << 20;
+
+// Contexts are kept for at most this many locales, the least recently used
+// being destroyed first.
+static const std::size_t MAX_CONTEXTS = 16;
+
+static volatile std::sig_atomic_t stopping = 0;
+
+
+static void
+on_stop_signal (int)
+{
+	stopping = 1;
+}
+
+
+static std::string
+get_default_socket ()
+{
+	const char *runtime_dir = std::getenv ("XDG_RUNTIME_DIR");
+	if (runtime_dir != NULL && *runtime_dir != '\0')
+		return std::string (runtime_dir) + "/elementald.socket";
+
+	std::ostringstream path;
+	path << "/tmp/elementald-" << getuid () << ".socket";
+	return path.str ();
+}
+
+//******************************************************************************
+
+class DaemonOptionGroup
+:	public Glib::OptionGroup
+{
+public:
+
+	DaemonOptionGroup ();
+
+	std::string socket;
+	int cache_size;
+};
+
+
+DaemonOptionGroup::DaemonOptionGroup ()
+:	Glib::OptionGroup (ustring (), ustring ()), cache_size (1024)
+{
+	set_translation_domain (GETTEXT_PACKAGE);
+
+	Glib::OptionEntry entry_socket;
+	entry_socket.set_long_name ("socket");
+	entry_socket.set_short_name ('S');
+	entry_socket.set_description (N_("Listen on the indicated socket"));
+	entry_socket.set_arg_description (N_("PATH"));
+	add_entry_filename (entry_socket, socket);
+
+	Glib::OptionEntry entry_cache_size;
+	entry_cache_size.set_long_name ("cache-size");
+	entry_cache_size.set_short_name ('c');
+	entry_cache_size.set_description (N_("Keep up to the indicated number "
+		"of responses in memory"));
+	entry_cache_size.set_arg_description (N_("COUNT"));
+	add_entry (entry_cache_size, cache_size);
+}
+
+//******************************************************************************
+
+// A least-recently-used store of rendered responses.
+class ResponseCache
+{
+public:
+
+	explicit ResponseCache (std::size_t capacity);
+
+	const std::string* find (const std::string& key);
+	const std::string& insert (const std::string& key,
+		const std::string& response);
+	void clear ();
+
+private:
+
+	typedef std::list<std::pair<std::string, std::string> > Entries;
+
+	std::size_t capacity;
+	Entries entries;
+	std::unordered_map<std::string, Entries::iterator> index;
+};
+
+
+ResponseCache::ResponseCache (std::size_t capacity_)
+:	capacity (capacity_)
+{}
+
+
+const std::string*
+ResponseCache::find (const std::string& key)
+{
+	std::unordered_map<std::string, Entries::iterator>::iterator found =
+		index.find (key);
+	if (found == index.end ()) return NULL;
+
+	entries.splice (entries.begin (), entries, found->second);
+	return &found->second->second;
+}
+
+
+const std::string&
+ResponseCache::insert (const std::string& key, const std::string& response)
+{
+	if (capacity == 0)
+	{
+		entries.assign (1, std::make_pair (key, response));
+		return entries.front ().second;
+	}
+
+	if (index.size () >= capacity)
+	{
+		index.erase (entries.back ().first);
+		entries.pop_back ();
+	}
+
+	entries.push_front (std::make_pair (key, response));
+	index[key] = entries.begin ();
+	return entries.front ().second;
+}
+
+
+void
+ResponseCache::clear ()
+{
+	index.clear ();
+	entries.clear ();
+}
+
+//******************************************************************************
+
+class Daemon
+{
+public:
+
+	Daemon (const std::string& path, std::size_t cache_size);
+	~Daemon ();
+
+	void run ();
+
+private:
+
+	struct Client
+	{
+		std::string input;
+		std::string output;
+		bool closing;
+	};
+
+	typedef std::list<std::pair<std::string, std::unique_ptr<Context> > >
+		Contexts;
+
+	void accept_clients ();
+	void read_client (int fd, Client& client);
+	void answer_requests (Client& client);
+	bool write_client (int fd, Client& client);
+	void close_client (int fd);
+
+	void answer (const std::string& request, std::string& response);
+	const Context& get_context (const std::string& locale);
+	static EntriesView* make_view (const std::string& format,
+		std::string& dest, std::ostringstream& text);
+
+	std::string path;
+	int listener;
+	int epoll;
+
+	std::map<int, Client> clients;
+	Contexts contexts;
+	ResponseCache cache;
+	Dataset::Ptr cached_dataset;
+};
+
+
+Daemon::Daemon (const std::string& path_, std::size_t cache_size)
+:	path (path_), listener (-1), epoll (-1), cache (cache_size)
+{
+	sockaddr_un address;
+	std::memset (&address, 0, sizeof address);
+	address.sun_family = AF_UNIX;
+	if (path.size () >= sizeof address.sun_path)
+		throw std::runtime_error (_("The socket path is too long."));
+	std::strcpy (address.sun_path, path.c_str ());
+
+	listener = socket (AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listener < 0)
+		throw std::runtime_error (std::strerror (errno));
+
+	// A socket left by a daemon that is no longer running is replaced. Any
+	// other kind of file is left alone.
+	struct stat existing;
+	if (lstat (path.c_str (), &existing) == 0)
+	{
+		if (!S_ISSOCK (existing.st_mode))
+		{
+			close (listener);
+			throw std::runtime_error (compose::ucompose
+				(_("\"%1\" exists and is not a socket."), path));
+		}
+
+		int probe = socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (probe >= 0)
+		{
+			bool running = connect (probe, (sockaddr*) &address,
+				sizeof address) == 0;
+			close (probe);
+			if (running)
+			{
+				close (listener);
+				throw std::runtime_error (compose::ucompose
+					(_("Another daemon is listening on \"%1\"."), path));
+			}
+		}
+		unlink (path.c_str ());
+	}
+
+	if (bind (listener, (sockaddr*) &address, sizeof address) < 0 ||
+		listen (listener, SOMAXCONN) < 0)
+	{
+		std::string error = std::strerror (errno);
+		close (listener);
+		throw std::runtime_error (error);
+	}
+
+	epoll = epoll_create1 (EPOLL_CLOEXEC);
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = listener;
+	if (epoll < 0 || epoll_ctl (epoll, EPOLL_CTL_ADD, listener, &event) < 0)
+	{
+		std::string error = std::strerror (errno);
+		if (epoll >= 0) close (epoll);
+		close (listener);
+		unlink (path.c_str ());
+		throw std::runtime_error (error);
+	}
+}
+
+
+Daemon::~Daemon ()
+{
+	while (!clients.empty ())
+		close_client (clients.begin ()->first);
+
+	close (epoll);
+	close (listener);
+	unlink (path.c_str ());
+}
+
+
+void
+Daemon::run ()
+{
+	epoll_event events[64];
+
+	while (!stopping)
+	{
+		int count = epoll_wait (epoll, events, G_N_ELEMENTS (events), -1);
+		if (count < 0)
+		{
+			if (errno == EINTR) continue;
+			throw std::runtime_error (std::strerror (errno));
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			int fd = events[i].data.fd;
+			if (fd == listener)
+			{
+				accept_clients ();
+				continue;
+			}
+
+			std::map<int, Client>::iterator client = clients.find (fd);
+			if (client == clients.end ()) continue;
+
+			if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+				read_client (fd, client->second);
+			else if (!write_client (fd, client->second))
+				close_client (fd);
+		}
+	}
+}
+
+
+void
+Daemon::accept_clients ()
+{
+	while (true)
+	{
+		int fd = accept4 (listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) return;
+
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		if (epoll_ctl (epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+		{
+			close (fd);
+			continue;
+		}
+
+		Client &client = clients[fd];
+		client.closing = false;
+	}
+}
+
+
+// Requests are answered as each chunk arrives, so that neither the input nor
+// the output of a client grows without bound.
+void
+Daemon::read_client (int fd, Client& client)
+{
+	char chunk[4096];
+	while (!client.closing && client.output.size () < MAX_PENDING_OUTPUT)
+	{
+		ssize_t length = read (fd, chunk, sizeof chunk);
+		if (length > 0)
+		{
+			client.input.append (chunk, length);
+			answer_requests (client);
+		}
+		else if (length == 0 || (errno != EAGAIN && errno != EINTR))
+			client.closing = true;
+		else if (errno == EAGAIN)
+			break;
+	}
+
+	if (!write_client (fd, client))
+		close_client (fd);
+}
+
+
+void
+Daemon::answer_requests (Client& client)
+{
+	std::string::size_type start = 0, end;
+	while ((end = client.input.find ('\n', start)) != std::string::npos)
+	{
+		answer (client.input.substr (start, end - start), client.output);
+		start = end + 1;
+	}
+	client.input.erase (0, start);
+
+	if (client.input.size () > MAX_REQUEST)
+	{
+		client.output += "ERR ";
+		client.output += _("The request is too long.");
+		client.output += '\n';
+		client.input.clear ();
+		client.closing = true;
+	}
+}
+
+
+bool
+Daemon::write_client (int fd, Client& client)
+{
+	while (!client.output.empty ())
+	{
+		ssize_t written = send (fd, client.output.data (),
+			client.output.size (), MSG_NOSIGNAL);
+		if (written > 0)
+			client.output.erase (0, written);
+		else if (errno == EAGAIN)
+			break;
+		else if (errno != EINTR)
+			return false;
+	}
+
+	// Wait for the socket to become writable only while output is pending.
+	epoll_event event;
+	event.events = client.output.empty () ? EPOLLIN : EPOLLOUT;
+	event.data.fd = fd;
+	epoll_ctl (epoll, EPOLL_CTL_MOD, fd, &event);
+
+	return !(client.closing && client.output.empty ());
+}
+
+
+void
+Daemon::close_client (int fd)
+{
+	epoll_ctl (epoll, EPOLL_CTL_DEL, fd, NULL);
+	close (fd);
+	clients.erase (fd);
+}
+
+
+void
+Daemon::answer (const std::string& request, std::string& response)
+{
+	std::istringstream words (request);
+	std::string command, which, keys, format, locale;
+	words >> command >> which;
+
+	if (command == "PING")
+	{
+		response += "OK 0\n";
+		return;
+	}
+	else if (command == "PROPERTY")
+		words >> keys;
+	else if (command != "ELEMENT")
+	{
+		response += "ERR ";
+		response += compose::ucompose (_("Unknown command \"%1\"."), command);
+		response += '\n';
+		return;
+	}
+
+	words >> format >> locale;
+	if (format.empty ()) format = "text";
+	if (locale.empty ()) locale = "-";
+
+	// Responses are only valid for the dataset they were rendered from.
+	Dataset::Ptr dataset = get_dataset ();
+	if (dataset != cached_dataset)
+	{
+		cache.clear ();
+		cached_dataset = dataset;
+	}
+
+	try
+	{
+		const Element *found;
+		try
+			{ found = &dataset->get_element (which); }
+		catch (std::invalid_argument&)
+		{
+			throw std::invalid_argument (compose::ucompose
+				(_("Unknown element \"%1\"."), which));
+		}
+		const Element &element = *found;
+
+		std::string key;
+		key += element.symbol;
+		key += ' ';
+		key += keys.empty () ? "*" : keys;
+		key += ' ';
+		key += format;
+		key += ' ';
+		key += locale;
+
+		const std::string *cached = cache.find (key);
+		if (cached != NULL)
+		{
+			response += *cached;
+			return;
+		}
+
+		std::vector<const PropertyBase*> properties;
+		std::string::size_type start = 0, end;
+		while (!keys.empty ())
+		{
+			end = keys.find (',', start);
+			std::string property = keys.substr (start, end - start);
+			if (!property.empty ())
+				try
+					{ properties.push_back (&get_property (property)); }
+				catch (std::invalid_argument&)
+				{
+					const Category *category;
+					try
+						{ category = &get_category (property); }
+					catch (std::invalid_argument&)
+					{
+						throw std::invalid_argument (compose::ucompose
+							(_("Unknown property \"%1\"."), property));
+					}
+					properties.insert (properties.end (),
+						category->properties.begin (),
+						category->properties.end ());
+				}
+			if (end == std::string::npos) break;
+			start = end + 1;
+		}
+
+		std::string body;
+		std::ostringstream text;
+		{
+			Context::Scope scope (get_context (locale));
+			std::unique_ptr<EntriesView> view (make_view (format, body, text));
+
+			if (keys.empty ())
+				element.make_entries (*view);
+			else
+			{
+				view->element_begin (element);
+				CONST_FOREACH (std::vector<const PropertyBase*>, properties,
+						prop)
+					element.make_entry (*view, **prop);
+				view->element_end ();
+			}
+			if (EntriesWriter *writer = CAST (view.get (), EntriesWriter))
+				writer->finish ();
+		}
+		body += text.str ();
+
+		std::ostringstream header;
+		header << "OK " << body.size () << '\n';
+		response += cache.insert (key, header.str () + body);
+	}
+	catch (std::exception& e)
+	{
+		response += "ERR ";
+		response += e.what ();
+		response += '\n';
+	}
+}
+
+
+const Context&
+Daemon::get_context (const std::string& locale)
+{
+	if (locale == "-")
+		return Context::get_global ();
+
+	FOREACH (Contexts, contexts, context)
+		if (context->first == locale)
+		{
+			contexts.splice (contexts.begin (), contexts, context);
+			return *contexts.front ().second;
+		}
+
+	std::unique_ptr<Context> created (new Context (locale));
+	if (contexts.size () >= MAX_CONTEXTS)
+		contexts.pop_back ();
+	contexts.push_front (std::make_pair (locale, std::move (created)));
+	return *contexts.front ().second;
+}
+
+
+EntriesView*
+Daemon::make_view (const std::string& format, std::string& dest,
+	std::ostringstream& text)
+{
+	if (format == "text")
+		return new EntriesStream (text);
+	else if (format == "tsv")
+		return new EntriesTSV (dest);
+	else if (format == "json")
+		return new EntriesJSON (dest);
+	else if (format == "ndjson")
+		return new EntriesNDJSON (dest);
+	else if (format == "csv")
+		return new EntriesCSV (dest);
+	else
+		throw std::invalid_argument (compose::ucompose
+			(_("Unknown format \"%1\"."), format));
+}
+
+//******************************************************************************
+
+int
+main (int argc, char** argv)
+{
+	bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
+	bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+	textdomain (GETTEXT_PACKAGE);
+
+	std::setlocale (LC_ALL, "");
+	try
+	{
+		std::locale::global (std::locale (std::setlocale (LC_ALL, NULL)));
+	}
+	catch (const std::runtime_error &)
+	{
+		std::locale::global (std::locale::classic ());
+	}
+
+	Glib::init ();
+	Glib::set_prgname ("elementald");
+
+	try
+	{
+		DaemonOptionGroup opts;
+		Glib::OptionContext context;
+		context.set_main_group (opts);
+#if GLIB_CHECK_VERSION (2, 12, 0)
+		g_option_context_set_summary (context.gobj (), _("Answers queries on "
+			"elements over a Unix-domain socket."));
+#endif
+		context.parse (argc, argv);
+
+		initialize ();
+
+		struct sigaction action;
+		std::memset (&action, 0, sizeof action);
+		action.sa_handler = on_stop_signal;
+		sigaction (SIGINT, &action, NULL);
+		sigaction (SIGTERM, &action, NULL);
+		std::signal (SIGPIPE, SIG_IGN);
+
+		Daemon daemon (opts.socket.empty () ? get_default_socket ()
+			: opts.socket, std::max (0, opts.cache_size));
+		daemon.run ();
+		return EXIT_SUCCESS;
+	}
+	catch (Glib::OptionError &e)
+	{
+		std::cerr << e.what () << std::endl;
+		std::cerr << compose::ucompose (_("Run '%1 --help' to see a full list "
+			"of available command line options."), argv[0]) << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (std::runtime_error &e)
+	{
+		std::cerr << e.what () << std::endl;
+		return EXIT_FAILURE;
+	}
+#ifndef ENABLE_DEBUG
+	catch (...)
+	{
+		std::cerr << _("An unknown error occurred.") << std::endl;
+		return EXIT_FAILURE;
+	}
+#endif // !ENABLE_DEBUG
+}
@@ -25,6 +25,7 @@
 #include "buttons.hh"
 
 #include <gdk/gdkkeysyms.h>
+#include <glibmm/main.h>
 #include <gtkmm/accelgroup.h>
 #include <gtkmm/alignment.h>
 #include <gtkmm/box.h>
@@ -41,8 +42,106 @@ namespace gElemental {
 // class ElementDialog
 
 
-ElementDialog::ElementDialog (const Element& el_)
-:	el (el_), tips ()
+// The categories shown on the pages after the first.
+static const Category* const PHYSICAL_PAGE[] =
+	{ &C_PHYSICAL, &C_THERMAL, NULL };
+static const Category* const ATOMIC_PAGE[] =
+	{ &C_ATOMIC, &C_CRYSTALLOGRAPHIC, &C_ELECTRONIC, NULL };
+
+// The greatest number of hidden dialogs kept for reuse.
+static const std::list<ElementDialog*>::size_type MAX_HIDDEN = 8;
+
+
+// Finds a page's tab label, and whether it has any entries, without formatting
+// the defined values.
+class PageProbe
+:	public EntriesView
+{
+public:
+
+	PageProbe ()
+	:	has_entries (false)
+	{}
+
+	virtual void
+	header (const ustring& category) throw ()
+	{
+		if (first_header.empty ())
+			first_header = category;
+	}
+
+	virtual void
+	entry (const ustring&, const ustring&, const ustring&) throw ()
+	{
+		has_entries = true;
+	}
+
+	virtual void
+	property_entry (const PropertyBase& property, const value_base& value)
+		throw ()
+	{
+		if (has_entries) return;
+		if (value.has_value ())
+			has_entries = true;
+		else
+			EntriesView::property_entry (property, value);
+	}
+
+	ustring first_header;
+	bool has_entries;
+};
+
+
+std::list<ElementDialog*> ElementDialog::hidden;
+
+
+ElementDialog&
+ElementDialog::get (const Dataset::Ptr& dataset, const Element& el)
+{
+	release_stale ();
+
+	FOREACH (std::list<ElementDialog*>, hidden, dialog)
+		if (&(*dialog)->el == &el)
+		{
+			ElementDialog &result = **dialog;
+			hidden.erase (dialog);
+			return result;
+		}
+
+	return *new ElementDialog (dataset, el);
+}
+
+
+void
+ElementDialog::release_hidden ()
+{
+	FOREACH (std::list<ElementDialog*>, hidden, dialog)
+		delete *dialog;
+	hidden.clear ();
+}
+
+
+// Hidden dialogs for a dataset which has since been replaced are destroyed, so
+// that they no longer keep it in memory.
+void
+ElementDialog::release_stale ()
+{
+	Dataset::Ptr current = get_dataset ();
+
+	std::list<ElementDialog*>::iterator dialog = hidden.begin ();
+	while (dialog != hidden.end ())
+		if ((*dialog)->dataset != current)
+		{
+			delete *dialog;
+			dialog = hidden.erase (dialog);
+		}
+		else
+			++dialog;
+}
+
+
+ElementDialog::ElementDialog (const Dataset::Ptr& dataset_, const Element& el_)
+:	dataset (dataset_), el (el_), tips ()
 {
 	set_border_width (6);
 	set_resizable (false);
@@ -54,11 +153,10 @@ ElementDialog::ElementDialog (const Element& el_)
 	Gtk::VBox *vbox = new Gtk::VBox (false, 6);
 	add (*Gtk::manage (vbox));
 
-	Gtk::Notebook *book = new Gtk::Notebook ();
-	vbox->pack_start (*Gtk::manage (book), Gtk::PACK_EXPAND_WIDGET);
+	vbox->pack_start (book, Gtk::PACK_EXPAND_WIDGET);
 
 	EntriesTable *table = new EntriesTable (tips, true);
-	book->append_page (*Gtk::manage (table), _("General"));
+	book.append_page (*Gtk::manage (table), _("General"));
 
 	Gtk::Alignment *align =
 		new Gtk::Alignment (Gtk::ALIGN_RIGHT, Gtk::ALIGN_CENTER, 0.0, 0.0);
@@ -79,24 +177,10 @@ ElementDialog::ElementDialog (const Element& el_)
 	table->trim ();
 	set_title (table->get_primary_header ());
 
-	table = new EntriesTable (tips, true);
-	el.make_entries (*table, C_PHYSICAL);
-	el.make_entries (*table, C_THERMAL);
-	table->trim ();
-	if (table->get_children ().empty ())
-		delete table;
-	else
-		book->append_page (*Gtk::manage (table), table->get_primary_header ());	
-
-	table = new EntriesTable (tips, true);
-	el.make_entries (*table, C_ATOMIC);
-	el.make_entries (*table, C_CRYSTALLOGRAPHIC);
-	el.make_entries (*table, C_ELECTRONIC);
-	table->trim ();
-	if (table->get_children ().empty ())
-		delete table;
-	else
-		book->append_page (*Gtk::manage (table), table->get_primary_header ());	
+	append_page (PHYSICAL_PAGE);
+	append_page (ATOMIC_PAGE);
+	book.signal_switch_page ().connect
+		(sigc::mem_fun (*this, &ElementDialog::on_switch_page));
 
 	Gtk::HButtonBox *hbox = new Gtk::HButtonBox (Gtk::BUTTONBOX_END);
 	vbox->pack_start (*Gtk::manage (hbox), Gtk::PACK_SHRINK);
@@ -112,11 +196,78 @@ ElementDialog::ElementDialog (const Element& el_)
 }
 
 
+// Closing the dialog hides it rather than destroying it, so that it may be
+// reused.
+bool
+ElementDialog::on_delete_event (GdkEventAny*)
+{
+	hide ();
+	return true;
+}
+
+
+// Hidden dialogs are kept for reuse by get(), one per element. They are
+// destroyed when they are the least recently hidden of more than MAX_HIDDEN,
+// or when their dataset has been replaced.
 void
 ElementDialog::on_hide ()
 {
 	Gtk::Window::on_hide ();
-	delete this;
+
+	FOREACH (std::list<ElementDialog*>, hidden, dialog)
+		if (&(*dialog)->el == &el)
+		{
+			delete *dialog;
+			hidden.erase (dialog);
+			break;
+		}
+
+	hidden.push_front (this);
+	if (hidden.size () > MAX_HIDDEN)
+	{
+		delete hidden.back ();
+		hidden.pop_back ();
+	}
+
+	// This dialog cannot be destroyed while its hide signal is emitted.
+	if (dataset != get_dataset ())
+		Glib::signal_idle ().connect (sigc::bind_return
+			(sigc::ptr_fun (&ElementDialog::release_stale), false));
+}
+
+
+// A page's entries are only made when the page is first selected. Pages that
+// would have no entries are omitted.
+void
+ElementDialog::append_page (const Category* const* categories)
+{
+	PageProbe probe;
+	for (const Category* const *category = categories; *category; ++category)
+		el.make_entries (probe, **category);
+	if (!probe.has_entries) return;
+
+	Page page = { new EntriesTable (tips, true), categories };
+	book.append_page (*Gtk::manage (page.table), probe.first_header);
+	pages.push_back (page);
+}
+
+
+void
+ElementDialog::on_switch_page (GtkNotebookPage*, guint page_num)
+{
+	Gtk::Widget *child = book.get_nth_page (page_num);
+	FOREACH (std::vector<Page>, pages, page)
+	{
+		if (page->table != child || page->categories == NULL) continue;
+
+		for (const Category* const *category = page->categories; *category;
+				++category)
+			el.make_entries (*page->table, **category);
+		page->table->trim ();
+		page->table->show_all ();
+		page->categories = NULL;
+		break;
+	}
 }
 
 
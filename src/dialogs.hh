@@ -23,9 +23,13 @@
 #define GELEMENTAL__DIALOGS_HH
 
 #include <libelemental/element.hh>
+#include <libelemental/table.hh>
 #include "misc.hh"
 
+#include <list>
+#include <vector>
 #include <gtkmm/box.h>
+#include <gtkmm/notebook.h>
 #include <gtkmm/tooltips.h>
 #include <gtkmm/treemodelcolumn.h>
 #include <gtkmm/treestore.h>
@@ -43,16 +47,38 @@ class ElementDialog
 {
 public:
 
-	ElementDialog (const Element& el);
+	static ElementDialog& get (const Dataset::Ptr& dataset, const Element& el);
+
+	// Destroys the hidden dialogs kept for reuse.
+	static void release_hidden ();
 
 protected:
 
+	virtual bool on_delete_event (GdkEventAny* event);
 	virtual void on_hide ();
 
 private:
 
+	ElementDialog (const Dataset::Ptr& dataset, const Element& el);
+
+	struct Page
+	{
+		EntriesTable *table;
+		const Category* const *categories;
+	};
+
+	void append_page (const Category* const* categories);
+	void on_switch_page (GtkNotebookPage* page, guint page_num);
+
+	static void release_stale ();
+
+	Dataset::Ptr dataset;
 	const Element& el;
 	Gtk::Tooltips tips;
+	Gtk::Notebook book;
+	std::vector<Page> pages;
+
+	static std::list<ElementDialog*> hidden;
 };
 
 //******************************************************************************
@@ -20,12 +20,14 @@
  */
 
 #include "private.hh"
+#include <libelemental/formats.hh>
 #include <libelemental/table.hh>
 #include "main.hh"
 
 #include <clocale>
 #include <iostream>
 #include <locale>
+#include <memory>
 #include <glib.h>
 #include <glibmm/optionentry.h>
 #include <gtk/gtkaboutdialog.h>
@@ -53,10 +55,22 @@ main (int argc, char** argv)
 
 namespace gElemental {
 
+
+// Ends the startup trace once the main window has been drawn.
+static bool
+on_startup_idle (StartupTrace::Phase* startup)
+{
+	startup->end ();
+	StartupTrace::finish ();
+	return false;
+}
+
 	
 int
 main (int& argc, char**& argv)
 {
+	StartupTrace::Phase startup ("startup");
+
 	bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
 	bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
 	textdomain (GETTEXT_PACKAGE);
@@ -75,7 +89,9 @@ main (int& argc, char**& argv)
 			"viewer with detailed information on elements."));
 #endif
 
+		StartupTrace::Phase gtk_phase ("Gtk::Main");
 		Gtk::Main kit (argc, argv, context);
+		gtk_phase.end ();
 		gtk_window_set_default_icon_name ("gelemental"); // unwrapped function
 
 		try
@@ -87,7 +103,10 @@ main (int& argc, char**& argv)
 			std::locale::global (std::locale::classic ());
 		}
 
-		initialize ();
+		{
+			StartupTrace::Phase phase ("initialize");
+			initialize ();
+		}
 
 		if (!opts.print.empty ())
 		{
@@ -96,13 +115,20 @@ main (int& argc, char**& argv)
 				return EXIT_SUCCESS;
 		}
 		
+		StartupTrace::Phase window_phase ("MainWindow");
 		MainWindow window;
 		window.present ();
+		window_phase.end ();
 
 		if (!opts.show.empty ())
 			opts.handle_show (window);
 
+		if (StartupTrace::is_enabled ())
+			Glib::signal_idle ().connect (sigc::bind (sigc::ptr_fun
+				(&on_startup_idle), &startup));
+
 		Gtk::Main::run (window);
+		ElementDialog::release_hidden ();
 		return EXIT_SUCCESS;
 	}
 	catch (Glib::OptionError &e)
@@ -139,6 +165,14 @@ MainOptionGroup::MainOptionGroup ()
 	entry_print.set_arg_description (N_("SYMBOL_OR_NUMBER"));
 	add_entry (entry_print, print);
 
+	Glib::OptionEntry entry_format;
+	entry_format.set_long_name ("format");
+	entry_format.set_short_name ('f');
+	entry_format.set_description (N_("Print information in the indicated "
+		"format: text, json, ndjson, or csv"));
+	entry_format.set_arg_description (N_("FORMAT"));
+	add_entry (entry_format, format);
+
 	Glib::OptionEntry entry_show;
 	entry_show.set_long_name ("show");
 	entry_show.set_short_name ('s');
@@ -159,31 +193,47 @@ MainOptionGroup::MainOptionGroup ()
 void
 MainOptionGroup::handle_print ()
 {
-	EntriesStream view (std::cout);
+	std::unique_ptr<EntriesView> view;
+	if (format.empty () || format == "text")
+		view.reset (new EntriesStream (std::cout));
+	else if (format == "json")
+		view.reset (new EntriesJSON (std::cout));
+	else if (format == "ndjson")
+		view.reset (new EntriesNDJSON (std::cout));
+	else if (format == "csv")
+		view.reset (new EntriesCSV (std::cout));
+	else
+		throw Glib::OptionError (Glib::OptionError::BAD_VALUE,
+			compose::ucompose (_("Unknown format \"%1\"."), format));
 
 	FOREACH (vecustrings, print, el)
 	{
 		try
-			{ get_element (*el).make_entries (view); }
+			{ get_element (*el).make_entries (*view); }
 		catch (std::invalid_argument& e)
 		{
 			throw Glib::OptionError (Glib::OptionError::BAD_VALUE,
 				compose::ucompose (_("Unknown element \"%1\"."), *el));
 		}
 	}
+
+	if (EntriesWriter *writer = CAST (view.get (), EntriesWriter))
+		writer->finish ();
 }
 
 
 void
 MainOptionGroup::handle_show (Gtk::Window& window)
 {
+	Dataset::Ptr dataset = get_dataset ();
 	FOREACH (vecustrings, show, el)
 	{
 		try
 		{
-			ElementDialog *dialog = new ElementDialog (get_element (*el));
-			dialog->set_transient_for (window);
-			dialog->present ();
+			ElementDialog &dialog =
+				ElementDialog::get (dataset, dataset->get_element (*el));
+			dialog.set_transient_for (window);
+			dialog.present ();
 		}
 		catch (std::invalid_argument& e)
 		{
@@ -207,6 +257,8 @@ MainWindow::MainWindow ()
 	add_accel_group (ui->get_accel_group ());
 	set_title (_("Periodic Table"));
 
+	StartupTrace::Phase ui_phase ("MainWindow UI manager");
+
 	actions->add (Gtk::Action::create ("FileMenu", _("_File")));
 	actions->add (Gtk::Action::create ("FileQuit", Gtk::Stock::QUIT),
 		sigc::mem_fun (*this, &MainWindow::hide));
@@ -243,6 +295,8 @@ MainWindow::MainWindow ()
 		"</menubar></ui>"
 	);
 
+	ui_phase.end ();
+
 	Gtk::Widget *menu_bar = ui->get_widget ("/MenuBar");
 	if (menu_bar != NULL)
 		vbox.pack_start (*Gtk::manage (menu_bar), Gtk::PACK_SHRINK);
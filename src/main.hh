@@ -46,6 +46,7 @@ public:
 	MainOptionGroup ();
 
 	vecustrings print;
+	ustring format;
 	void handle_print ();
 	
 	bool interactive;
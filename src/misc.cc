@@ -22,6 +22,12 @@
 #include "private.hh"
 #include "misc.hh"
 
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
 #include <glibmm/main.h>
 #include <gtkmm/eventbox.h>
 #include <gtkmm/label.h>
@@ -29,12 +35,53 @@
 namespace gElemental {
 
 
-Gdk::Color
+// Colors and styles are shared by every widget using the same color. They are
+// keyed by their 16-bit components, as Gdk::Color stores them, and never freed;
+// the table's values produce no more than a few thousand colors.
+
+struct SharedColor
+{
+	Gdk::Color color;
+	RefPtr<Gtk::Style> style;
+};
+
+static SharedColor&
+get_shared (const color& color)
+{
+	static std::unordered_map<guint64, SharedColor> cache;
+
+	Gdk::Color key_color;
+	key_color.set_rgb_p (color.red, color.green, color.blue);
+	guint64 key = (guint64 (key_color.get_red ()) << 32) |
+		(guint64 (key_color.get_green ()) << 16) | key_color.get_blue ();
+
+	std::pair<std::unordered_map<guint64, SharedColor>::iterator, bool>
+		found = cache.insert (std::make_pair (key, SharedColor ()));
+	if (found.second)
+		found.first->second.color = key_color;
+	return found.first->second;
+}
+
+
+const Gdk::Color&
 allocate (const color& color)
 {
-	Gdk::Color result;
-	result.set_rgb_p (color.red, color.green, color.blue);
-	return result;
+	return get_shared (color).color;
+}
+
+
+RefPtr<Gtk::Style>
+get_color_style (const color& bg)
+{
+	SharedColor &shared = get_shared (bg);
+	if (!shared.style)
+	{
+		shared.style = Gtk::Style::create ();
+		shared.style->set_bg (Gtk::STATE_NORMAL, shared.color);
+		shared.style->set_bg (Gtk::STATE_ACTIVE, shared.color);
+		shared.style->set_bg (Gtk::STATE_PRELIGHT, shared.color);
+	}
+	return shared.style;
 }
 
 
@@ -187,4 +234,92 @@ SortColumn::on_sort_menu ()
 }
 
 
+//******************************************************************************
+// class StartupTrace
+
+
+struct TraceEvent
+{
+	const char *name;
+	long start;
+	long duration;
+};
+
+
+static std::vector<TraceEvent> trace_events;
+static bool trace_finished = false;
+
+
+bool
+StartupTrace::is_enabled ()
+{
+	static const char *path = std::getenv ("GELEMENTAL_STARTUP_TRACE");
+	return path != NULL && *path != '\0' && !trace_finished;
+}
+
+
+void
+StartupTrace::finish ()
+{
+	if (!is_enabled ()) return;
+	trace_finished = true;
+
+	std::ofstream file (std::getenv ("GELEMENTAL_STARTUP_TRACE"));
+	file << "{\"traceEvents\":[";
+
+	long pid = getpid ();
+	for (std::vector<TraceEvent>::size_type i = 0; i < trace_events.size (); ++i)
+	{
+		const TraceEvent &event = trace_events[i];
+		file << (i ? ",\n" : "\n") << "{\"name\":\"" << event.name
+			<< "\",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":" << event.start
+			<< ",\"dur\":" << event.duration << ",\"pid\":" << pid
+			<< ",\"tid\":" << pid << '}';
+	}
+
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	trace_events.clear ();
+}
+
+
+long
+StartupTrace::now ()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>
+		(std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+
+void
+StartupTrace::record (const char* name, long start, long duration)
+{
+	TraceEvent event = { name, start, duration };
+	trace_events.push_back (event);
+}
+
+
+//******************************************************************************
+// class StartupTrace::Phase
+
+
+StartupTrace::Phase::Phase (const char* name_)
+:	name (is_enabled () ? name_ : NULL), start (name ? now () : 0)
+{}
+
+
+StartupTrace::Phase::~Phase ()
+{
+	end ();
+}
+
+
+void
+StartupTrace::Phase::end ()
+{
+	if (name != NULL && is_enabled ())
+		record (name, start, now () - start);
+	name = NULL;
+}
+
+
 } // namespace gElemental
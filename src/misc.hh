@@ -30,6 +30,7 @@
 #include <stdexcept>
 #include <glibmm/timer.h>
 #include <gdkmm/color.h>
+#include <gtkmm/style.h>
 #include <gtkmm/radioaction.h>
 #include <gtkmm/table.h>
 #include <gtkmm/tooltips.h>
@@ -42,7 +43,8 @@ namespace gElemental {
 
 using namespace Elemental;
 
-Gdk::Color allocate (const color& color);
+const Gdk::Color& allocate (const color& color);
+RefPtr<Gtk::Style> get_color_style (const color& bg);
 
 //******************************************************************************
 
@@ -206,6 +208,42 @@ ValueColumn<T>::on_cell_data (Gtk::CellRenderer* cell,
 	}
 }
 
+//******************************************************************************
+
+// Records the times of startup phases if the GELEMENTAL_STARTUP_TRACE
+// environment variable names a file, to which finish() writes them as Chrome
+// trace events. Otherwise, nothing is recorded.
+class StartupTrace
+{
+public:
+
+	// Records a phase from construction until end() or destruction.
+	class Phase
+	{
+	public:
+
+		explicit Phase (const char* name);
+		~Phase ();
+
+		void end ();
+
+	private:
+
+		const char *name;
+		long start;
+	};
+
+	static bool is_enabled ();
+
+	// Writes the recorded events. Later events are not recorded.
+	static void finish ();
+
+private:
+
+	static long now ();
+	static void record (const char* name, long start, long duration);
+};
+
 } // namespace gElemental
 
 #endif // GELEMENTAL__MISC_HH
@@ -0,0 +1,562 @@
+/*
+ * This file is part of gElemental, a periodic table viewer with detailed
+ * information on elements.
+ *
+ * Copyright (C) 2026 gElemental contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// elemental-query prints element data without GTK+; it links only libelemental.
+
+#include "private.hh"
+#include <libelemental/formats.hh>
+#include <libelemental/table.hh>
+
+#include <algorithm>
+#include <clocale>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <glib.h>
+#include <glibmm/init.h>
+#include <glibmm/optioncontext.h>
+#include <glibmm/optionentry.h>
+#include <glibmm/optiongroup.h>
+
+using namespace Elemental;
+
+//******************************************************************************
+
+class QueryOptionGroup
+:	public Glib::OptionGroup
+{
+public:
+
+	QueryOptionGroup ();
+
+	ustring format;
+	EntriesView* make_view () const;
+	EntriesWriter* make_writer (std::string& dest) const;
+
+	vecustrings property_keys;
+	std::vector<const PropertyBase*> properties;
+	void resolve_properties ();
+
+	bool batch;
+	int threads;
+	bool handle_batch () const;
+
+	vecustrings elements;
+};
+
+
+QueryOptionGroup::QueryOptionGroup ()
+:	Glib::OptionGroup (ustring (), ustring ()), batch (false), threads (1)
+{
+	set_translation_domain (GETTEXT_PACKAGE);
+
+	Glib::OptionEntry entry_format;
+	entry_format.set_long_name ("format");
+	entry_format.set_short_name ('f');
+	entry_format.set_description (N_("Print information in the indicated "
+		"format: text, tsv, json, ndjson, or csv"));
+	entry_format.set_arg_description (N_("FORMAT"));
+	add_entry (entry_format, format);
+
+	Glib::OptionEntry entry_property;
+	entry_property.set_long_name ("property");
+	entry_property.set_short_name ('P');
+	entry_property.set_description (N_("Print only the indicated property "
+		"or category of properties"));
+	entry_property.set_arg_description (N_("KEY"));
+	add_entry (entry_property, property_keys);
+
+	Glib::OptionEntry entry_batch;
+	entry_batch.set_long_name ("batch");
+	entry_batch.set_short_name ('b');
+	entry_batch.set_description (N_("Read one query per line from standard "
+		"input and print one line per query"));
+	add_entry (entry_batch, batch);
+
+	Glib::OptionEntry entry_threads;
+	entry_threads.set_long_name ("threads");
+	entry_threads.set_short_name ('j');
+	entry_threads.set_description (N_("Answer batch queries in the indicated "
+		"number of threads, or 0 for one per processor"));
+	entry_threads.set_arg_description (N_("COUNT"));
+	add_entry (entry_threads, threads);
+
+	Glib::OptionEntry entry_elements;
+	entry_elements.set_long_name (G_OPTION_REMAINING);
+	entry_elements.set_arg_description (N_("[SYMBOL_OR_NUMBER...]"));
+	add_entry (entry_elements, elements);
+}
+
+
+EntriesView*
+QueryOptionGroup::make_view () const
+{
+	if (format.empty () || format == "text")
+		return new EntriesStream (std::cout);
+	else if (format == "tsv")
+		return new EntriesTSV (std::cout);
+	else if (format == "json")
+		return new EntriesJSON (std::cout);
+	else if (format == "ndjson")
+		return new EntriesNDJSON (std::cout);
+	else if (format == "csv")
+		return new EntriesCSV (std::cout);
+	else
+		throw Glib::OptionError (Glib::OptionError::BAD_VALUE,
+			compose::ucompose (_("Unknown format \"%1\"."), format));
+}
+
+
+void
+QueryOptionGroup::resolve_properties ()
+{
+	CONST_FOREACH (vecustrings, property_keys, keys)
+	{
+		// Each option may list several keys, separated by commas.
+		ustring::size_type start = 0, end;
+		do
+		{
+			end = keys->find (',', start);
+			std::string key = keys->substr (start, end - start);
+			start = end + 1;
+			if (key.empty ()) continue;
+
+			try
+			{
+				properties.push_back (&get_property (key));
+				continue;
+			}
+			catch (std::invalid_argument&) {}
+
+			try
+			{
+				const Category &category = get_category (key);
+				properties.insert (properties.end (),
+					category.properties.begin (), category.properties.end ());
+			}
+			catch (std::invalid_argument&)
+			{
+				throw Glib::OptionError (Glib::OptionError::BAD_VALUE,
+					compose::ucompose (_("Unknown property \"%1\"."), key));
+			}
+		}
+		while (end != ustring::npos);
+	}
+}
+
+EntriesWriter*
+QueryOptionGroup::make_writer (std::string& dest) const
+{
+	if (format.empty () || format == "tsv" || format == "text")
+		return new EntriesTSV (dest);
+	else if (format == "ndjson" || format == "json")
+		return new EntriesNDJSON (dest);
+	else
+		throw Glib::OptionError (Glib::OptionError::BAD_VALUE,
+			compose::ucompose (_("The format \"%1\" cannot be used with "
+				"--batch."), format));
+}
+
+//******************************************************************************
+
+static bool
+print_element (const QueryOptionGroup& opts, EntriesView& view,
+	const std::string& which)
+{
+	const Element *element;
+	try
+		{ element = &get_element (which); }
+	catch (std::invalid_argument&)
+	{
+		std::cerr << compose::ucompose (_("Unknown element \"%1\"."), which)
+			<< std::endl;
+		return false;
+	}
+
+	if (opts.properties.empty ())
+		element->make_entries (view);
+	else
+	{
+		view.element_begin (*element);
+		CONST_FOREACH (std::vector<const PropertyBase*>, opts.properties, prop)
+			element->make_entry (view, **prop);
+		view.element_end ();
+	}
+	return true;
+}
+
+
+//******************************************************************************
+// Batch queries
+
+
+// The number of lines of input answered together in one thread.
+static const std::size_t BATCH_CHUNK = 4096;
+
+// The number of chunks read ahead of those being answered, whatever the number
+// of threads.
+static const std::size_t BATCH_READ_AHEAD = 4;
+
+
+struct BatchChunk
+{
+	BatchChunk () : answered (false) {}
+
+	std::size_t first_line;
+	std::vector<std::string> queries;
+
+	std::string output;
+	std::string errors;
+
+	bool answered;
+};
+
+
+// A fixed set of threads which answer chunks taken from a queue.
+class BatchWorkers
+{
+public:
+
+	BatchWorkers (const QueryOptionGroup& opts, unsigned int count);
+
+	// Answers any chunks still queued, then stops the threads.
+	~BatchWorkers ();
+
+	// Queues a chunk, which must remain valid until it has been answered.
+	void submit (BatchChunk& chunk);
+
+	// Waits until a submitted chunk has been answered.
+	void wait (const BatchChunk& chunk);
+
+private:
+
+	void run ();
+
+	const QueryOptionGroup &opts;
+
+	std::mutex lock;
+	std::condition_variable queued, answered;
+	std::deque<BatchChunk*> queue;
+	bool stopping;
+
+	std::vector<std::thread> threads;
+};
+
+
+// Answers a single query, a symbol or number optionally followed by a colon and
+// a property key, with one record. Returns an error message on failure.
+static ustring
+answer_query (const QueryOptionGroup& opts, EntriesWriter& writer,
+	const std::string& query)
+{
+	std::string::size_type begin = query.find_first_not_of (" \t\r");
+	std::string::size_type end = query.find_last_not_of (" \t\r");
+	if (begin == std::string::npos)
+	{
+		writer.empty_record ();
+		return ustring ();
+	}
+
+	std::string which = query.substr (begin, end - begin + 1), key;
+	std::string::size_type colon = which.find (':');
+	if (colon != std::string::npos)
+	{
+		key = which.substr (colon + 1);
+		which.erase (colon);
+	}
+
+	const Element *element;
+	const PropertyBase *property = NULL;
+	try
+		{ element = &get_element (which); }
+	catch (std::invalid_argument&)
+	{
+		writer.empty_record ();
+		return compose::ucompose (_("Unknown element \"%1\"."), which);
+	}
+
+	if (!key.empty ())
+		try
+			{ property = &get_property (key); }
+		catch (std::invalid_argument&)
+		{
+			writer.empty_record ();
+			return compose::ucompose (_("Unknown property \"%1\"."), key);
+		}
+
+	writer.element_begin (*element);
+	if (property != NULL)
+		element->make_entry (writer, *property);
+	else
+		CONST_FOREACH (std::vector<const PropertyBase*>, opts.properties, prop)
+			element->make_entry (writer, **prop);
+	writer.element_end ();
+
+	return ustring ();
+}
+
+
+static void
+answer_chunk (const QueryOptionGroup& opts, BatchChunk& chunk)
+{
+	std::unique_ptr<EntriesWriter> writer (opts.make_writer (chunk.output));
+
+	std::size_t line = chunk.first_line;
+	CONST_FOREACH (std::vector<std::string>, chunk.queries, query)
+	{
+		ustring error = answer_query (opts, *writer, *query);
+		if (!error.empty ())
+		{
+			chunk.errors += compose::ucompose (_("Line %1: %2"), line, error);
+			chunk.errors += '\n';
+		}
+		++line;
+	}
+	writer->finish ();
+}
+
+
+static bool
+write_chunk (const BatchChunk& chunk)
+{
+	std::cout.write (chunk.output.data (), chunk.output.size ());
+	std::cerr << chunk.errors;
+	return chunk.errors.empty ();
+}
+
+
+BatchWorkers::BatchWorkers (const QueryOptionGroup& opts_, unsigned int count)
+:	opts (opts_), stopping (false)
+{
+	threads.reserve (count);
+	while (threads.size () < count)
+		threads.push_back (std::thread (&BatchWorkers::run, this));
+}
+
+
+BatchWorkers::~BatchWorkers ()
+{
+	{
+		std::lock_guard<std::mutex> guard (lock);
+		stopping = true;
+	}
+	queued.notify_all ();
+	FOREACH (std::vector<std::thread>, threads, thread)
+		thread->join ();
+}
+
+
+void
+BatchWorkers::submit (BatchChunk& chunk)
+{
+	{
+		std::lock_guard<std::mutex> guard (lock);
+		queue.push_back (&chunk);
+	}
+	queued.notify_one ();
+}
+
+
+void
+BatchWorkers::wait (const BatchChunk& chunk)
+{
+	std::unique_lock<std::mutex> guard (lock);
+	answered.wait (guard, [&chunk] { return chunk.answered; });
+}
+
+
+void
+BatchWorkers::run ()
+{
+	std::unique_lock<std::mutex> guard (lock);
+	while (true)
+	{
+		queued.wait (guard, [this] { return stopping || !queue.empty (); });
+		if (queue.empty ()) return;
+
+		BatchChunk &chunk = *queue.front ();
+		queue.pop_front ();
+
+		guard.unlock ();
+		try
+			{ answer_chunk (opts, chunk); }
+		catch (std::exception& e)
+		{
+			chunk.errors += e.what ();
+			chunk.errors += '\n';
+		}
+		guard.lock ();
+
+		chunk.answered = true;
+		answered.notify_all ();
+	}
+}
+
+
+bool
+QueryOptionGroup::handle_batch () const
+{
+	// Fail on an unsupported format before any input is read.
+	std::string ignored;
+	delete make_writer (ignored);
+
+	unsigned int workers = (threads > 0) ? threads
+		: std::max (1u, std::thread::hardware_concurrency ());
+
+	// Chunks are answered in order of reading, and each is written out as soon
+	// as those before it. One chunk per worker is in progress at once, plus a
+	// few read ahead for workers which finish early.
+	std::deque<std::unique_ptr<BatchChunk> > pending;
+	std::unique_ptr<BatchWorkers> pool;
+	if (workers > 1)
+		pool.reset (new BatchWorkers (*this, workers));
+	bool success = true, more = true;
+	std::size_t next_line = 1;
+
+	while (more)
+	{
+		std::unique_ptr<BatchChunk> chunk (new BatchChunk);
+		chunk->first_line = next_line;
+		chunk->queries.reserve (BATCH_CHUNK);
+
+		std::string line;
+		while (chunk->queries.size () < BATCH_CHUNK &&
+				(more = bool (std::getline (std::cin, line))))
+			chunk->queries.push_back (line);
+		next_line += chunk->queries.size ();
+		if (chunk->queries.empty ()) break;
+
+		if (pool == NULL)
+		{
+			answer_chunk (*this, *chunk);
+			success &= write_chunk (*chunk);
+			continue;
+		}
+
+		if (pending.size () >= workers + BATCH_READ_AHEAD)
+		{
+			pool->wait (*pending.front ());
+			success &= write_chunk (*pending.front ());
+			pending.pop_front ();
+		}
+
+		pool->submit (*chunk);
+		pending.push_back (std::move (chunk));
+	}
+
+	for (; !pending.empty (); pending.pop_front ())
+	{
+		pool->wait (*pending.front ());
+		success &= write_chunk (*pending.front ());
+	}
+
+	std::cout.flush ();
+	return success;
+}
+
+
+//******************************************************************************
+
+
+int
+main (int argc, char** argv)
+{
+	bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
+	bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+	textdomain (GETTEXT_PACKAGE);
+
+	std::setlocale (LC_ALL, "");
+	try
+	{
+		std::locale::global (std::locale (std::setlocale (LC_ALL, NULL)));
+	}
+	catch (const std::runtime_error &)
+	{
+		std::locale::global (std::locale::classic ());
+	}
+	std::ios::sync_with_stdio (false);
+
+	Glib::init ();
+	Glib::set_prgname ("elemental-query");
+
+	try
+	{
+		QueryOptionGroup opts;
+		Glib::OptionContext context;
+		context.set_main_group (opts);
+#if GLIB_CHECK_VERSION (2, 12, 0)
+		g_option_context_set_summary (context.gobj (), _("Prints information "
+			"on the indicated elements, or on those read from standard "
+			"input."));
+#endif
+		context.parse (argc, argv);
+
+		initialize ();
+		opts.resolve_properties ();
+
+		if (opts.batch)
+		{
+			if (opts.properties.empty ())
+				CONST_FOREACH (std::list<Category*>, CATEGORIES, category)
+					opts.properties.insert (opts.properties.end (),
+						(*category)->properties.begin (),
+						(*category)->properties.end ());
+
+			return opts.handle_batch () ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		std::unique_ptr<EntriesView> view (opts.make_view ());
+
+		bool success = true;
+		if (!opts.elements.empty ())
+		{
+			CONST_FOREACH (QueryOptionGroup::vecustrings, opts.elements, el)
+				success &= print_element (opts, *view, *el);
+		}
+		else
+		{
+			std::string which;
+			while (std::cin >> which)
+				success &= print_element (opts, *view, which);
+		}
+
+		if (EntriesWriter *writer = CAST (view.get (), EntriesWriter))
+			writer->finish ();
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (Glib::OptionError &e)
+	{
+		std::cerr << e.what () << std::endl;
+		std::cerr << compose::ucompose (_("Run '%1 --help' to see a full list "
+			"of available command line options."), argv[0]) << std::endl;
+		return EXIT_FAILURE;
+	}
+#ifndef ENABLE_DEBUG
+	catch (...)
+	{
+		std::cerr << _("An unknown error occurred.") << std::endl;
+		return EXIT_FAILURE;
+	}
+#endif // !ENABLE_DEBUG
+}
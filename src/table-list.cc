@@ -74,7 +74,7 @@ TableListStore::create ()
 
 
 TableListStore::TableListStore ()
-:	Gtk::ListStore (TableListColumns::get ()),
+:	Gtk::ListStore (TableListColumns::get ()), dataset (get_dataset ()),
 	cols (TableListColumns::get ())
 {
 	set_sort_func (cols.group, sigc::bind (sigc::mem_fun
@@ -84,7 +84,7 @@ TableListStore::TableListStore ()
 	set_sort_func (cols.block, sigc::bind (sigc::mem_fun
 		(*this, &TableListStore::on_value_sort<Block>), cols.block));
 
-	CONST_FOREACH (Table, get_table (), el)
+	CONST_FOREACH (Table, dataset->get_table (), el)
 	{
 		Gtk::TreeIter j = append ();
 		j->set_value (cols.el, *el);
@@ -136,7 +136,7 @@ TableListStore::on_value_sort (const Gtk::TreeIter& a, const Gtk::TreeIter& b,
 // class PropertyColumn
 
 
-PropertyColumn::PropertyColumn (const RefPtr<Gtk::ListStore>& store_,
+PropertyColumn::PropertyColumn (const RefPtr<TableListStore>& store_,
 	Gtk::RadioButtonGroup& group)
 :	SortColumn (ustring (), false, group, "ViewSortByExtra",
 		_("by _Extra Property")),
@@ -163,6 +163,7 @@ void
 PropertyColumn::set_property (PropertyBase* property_)
 {
 	property = property_;
+	render_cells ();
 
 	if (property != NULL)
 	{
@@ -206,6 +207,36 @@ PropertyColumn::on_value_sort (const Gtk::TreeIter& a, const Gtk::TreeIter& b)
 }
 
 
+// The cells of every element are rendered when the property is set, so that
+// redrawing the column only assigns them.
+void
+PropertyColumn::render_cells ()
+{
+	cells.clear ();
+	if (property == NULL) return;
+
+	const Table &table = store->dataset->get_table ();
+	cells.resize (table.size ());
+	CONST_FOREACH (Table, table, el)
+	{
+		RenderedCell &rendered = cells[(*el)->number - 1];
+		const value_base &value = (*el)->get_property_base (*property);
+		rendered.markup = value.get_string (property->get_format ());
+
+		const color_value_base *color_value =
+			CAST (&value, const color_value_base);
+		if (value.has_value () && color_value != NULL)
+		{
+			color background = color_value->get_color ();
+			rendered.background = &allocate (background);
+			rendered.foreground = &allocate (background.get_compliment ());
+		}
+		else
+			rendered.background = rendered.foreground = NULL;
+	}
+}
+
+
 void
 PropertyColumn::on_cell_data (Gtk::CellRenderer* cell,
 	const Gtk::TreeIter& iter)
@@ -213,20 +244,17 @@ PropertyColumn::on_cell_data (Gtk::CellRenderer* cell,
 	if (cell == NULL || !iter) return;
 	if (property != NULL)
 	{
-		const Element& el = *iter->get_value (el_col);
-		const value_base& value = el.get_property_base (*property);
+		const RenderedCell &rendered =
+			cells[iter->get_value (el_col)->number - 1];
 		if cast (cell, Gtk::CellRendererText, text)
 		{
-			text->property_markup ().set_value
-				(value.get_string (property->get_format ()));
-			const color_value_base *color_value =
-				CAST (&value, const color_value_base);
-			if (value.has_value () && color_value != NULL)
+			text->property_markup ().set_value (rendered.markup);
+			if (rendered.background != NULL)
 			{
 				text->property_background_gdk ().set_value
-					(allocate (color_value->get_color ()));
+					(*rendered.background);
 				text->property_foreground_gdk ().set_value
-					(allocate (color_value->get_color ().get_compliment ()));
+					(*rendered.foreground);
 			}
 			else
 			{
@@ -483,10 +511,10 @@ TableList::on_row_activated (const Gtk::TreePath& treepath,
 	const Element *el = iter->get_value (cols.el);
 	if (el != NULL)
 	{
-		ElementDialog *dialog = new ElementDialog (*el);
+		ElementDialog &dialog = ElementDialog::get (store->dataset, *el);
 		if cast (get_toplevel (), Gtk::Window, top)
-			dialog->set_transient_for (*top);
-		dialog->present ();
+			dialog.set_transient_for (*top);
+		dialog.present ();
 	}			
 }
 
@@ -22,8 +22,10 @@
 #ifndef GELEMENTAL__TABLE_LIST_HH
 #define GELEMENTAL__TABLE_LIST_HH
 
+#include <libelemental/table.hh>
 #include "misc.hh"
 
+#include <vector>
 #include <gtkmm/actiongroup.h>
 #include <gtkmm/liststore.h>
 #include <gtkmm/scrolledwindow.h>
@@ -67,6 +69,8 @@ public:
 
 	static int default_sort (const Gtk::TreeIter& a, const Gtk::TreeIter& b);
 
+	const Dataset::Ptr dataset;
+
 protected:
 
 	TableListStore ();
@@ -84,7 +88,7 @@ class PropertyColumn
 {
 public:
 
-	PropertyColumn (const RefPtr<Gtk::ListStore>& store,
+	PropertyColumn (const RefPtr<TableListStore>& store,
 		Gtk::RadioButtonGroup& group);
 	
 	PropertyBase* get_property () const;
@@ -101,9 +105,18 @@ protected:
 
 private:
 
-	RefPtr<Gtk::ListStore> store;
+	struct RenderedCell
+	{
+		ustring markup;
+		const Gdk::Color *background, *foreground;
+	};
+
+	void render_cells ();
+
+	RefPtr<TableListStore> store;
 	Gtk::TreeModelColumn<const Element*> &el_col;
 	PropertyBase *property;
+	std::vector<RenderedCell> cells;
 };
 
 //******************************************************************************
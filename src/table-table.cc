@@ -43,14 +43,20 @@ TableTable::TableTable (const RefPtr<Gtk::UIManager>& ui_)
 	button_table (10, 18, true), next_reference (1),
 	focus_el (NULL), hover_el (NULL),
 	throttle_clear_hover (misc::Throttle::DELAY, 1.0), display (false, 6),
+	display_shown (NULL),
 	color_by (NULL), temperature (STANDARD_TEMPERATURE, 0, DBL_MAX, 10, 100),
-	throttle_update_temperature (misc::Throttle::LIMIT, 0.5),
+	throttle_update_temperature (misc::Throttle::ADAPTIVE, 0.5),
 	logarithmic (_("Lo_garithmic"), true),
 	legend (_("_Legend"), true),
 	conditions (_("_At %1 K and standard pressure"), true), scales (false, 6)
 {
 	set_border_width (12);
 	
+	display_identity.set_no_show_all (true);
+	display.pack_start (display_identity, Gtk::PACK_SHRINK);
+	display_name.set_no_show_all (true);
+	display.pack_start (display_name, Gtk::PACK_SHRINK);
+
 	populate_button_table ();
 	update_display ();
 	pack_start (button_table, Gtk::PACK_EXPAND_WIDGET);
@@ -99,6 +105,7 @@ TableTable::TableTable (const RefPtr<Gtk::UIManager>& ui_)
 		_("_Element")), sigc::bind (sigc::mem_fun
 			(*this, &TableTable::on_color_by_changed), &P_COLOR));
 
+	StartupTrace::Phase menu_phase ("TableTable menu");
 	ustring extra_ui;
 	int n = 1;
 	RefPtr<Gtk::Action> initial_action;
@@ -145,6 +152,7 @@ TableTable::TableTable (const RefPtr<Gtk::UIManager>& ui_)
 			"<menuitem action='ViewShowLegend' />"
 		"</menu></menubar></ui>"
 	);
+	menu_phase.end ();
 
 	show_all_children ();
 	if (initial_action)
@@ -188,9 +196,14 @@ TableTable::set_state (State& state)
 void
 TableTable::populate_button_table ()
 {
-	CONST_FOREACH (Table, get_table (), el)
+	StartupTrace::Phase phase ("TableTable::populate_button_table");
+	dataset = get_dataset ();
+	buttons.reserve (dataset->get_table ().size ());
+
+	CONST_FOREACH (Table, dataset->get_table (), el)
 	{
-		ElementButton *button = new ElementButton (**el, tips);
+		ElementButton *button = new ElementButton (dataset, **el, tips);
+		buttons.push_back (button);
 		int x = button->get_x_pos (), y = button->get_y_pos ();
 		button_table.attach (*Gtk::manage (button), x, x + 1, y, y + 1,
 			Gtk::FILL, Gtk::FILL, 2, 2);
@@ -226,11 +239,12 @@ TableTable::update_colors ()
 {
 	update_display ();
 
-	Glib::ListHandle<Gtk::Widget*> list = button_table.get_children ();
-	CONST_FOREACH (Glib::ListHandle<Gtk::Widget*>, list, child)
-		if cast (*child, ElementButton, button)
-			button->set_color_by_property (color_by,
-				temperature.get_value (), logarithmic.get_active ());
+	// Buttons whose colors are unchanged are skipped by the buttons themselves.
+	double temperature_value = temperature.get_value ();
+	bool logarithmic_value = logarithmic.get_active ();
+	FOREACH (std::vector<ElementButton*>, buttons, button)
+		(*button)->set_color_by_property (color_by, temperature_value,
+			logarithmic_value);
 }
 
 
@@ -288,35 +302,56 @@ TableTable::clear_hover ()
 }
 
 
+// The display's widgets are reused, and its markup is cached for the current
+// color_by property, so that sweeping the pointer across the table allocates
+// nothing once each element has been shown.
 void
 TableTable::update_display ()
 {
 	if (display.gobj () == NULL) return;
 
-	display.children ().erase
-		(display.children ().begin (), display.children ().end ());
-
 	const Element *el = (hover_el != NULL) ? hover_el : focus_el;
-	if (el == NULL) return;
+	if (el == NULL)
+	{
+		display_identity.hide ();
+		display_name.hide ();
+		return;
+	}
 
-	ElementIdentity *id = new ElementIdentity (*el);
-	id->show ();
-	display.pack_start (*Gtk::manage (id), Gtk::PACK_SHRINK);
+	// Phase markup depends on the temperature only through the phase.
+	Phase phase;
+	int phase_key = -1;
+	if (color_by == &P_PHASE)
+	{
+		phase = el->get_phase (temperature.get_value ());
+		if (phase.has_value ()) phase_key = phase.value;
+	}
 
-	ustring markup =
-		el->get_property (P_NAME).get_string ("<big><b>%1</b></big>");
+	std::pair<MarkupCache::iterator, bool> cached = display_markup.insert
+		(MarkupCache::value_type (std::make_pair (el, phase_key), ustring ()));
+	ustring &markup = cached.first->second;
 
-	if (color_by == &P_PHASE)
-		markup += "\n" + el->get_phase (temperature.get_value ()).get_string ();
+	if (cached.second)
+	{
+		markup = el->get_property (P_NAME).get_string ("<big><b>%1</b></big>");
+
+		if (color_by == &P_PHASE)
+			markup += "\n" + phase.get_string ();
+
+		else if (color_by != NULL)
+			markup += "\n" + el->get_property_base (*color_by)
+				.get_string (color_by->get_format ());
+	}
 
-	else if (color_by != NULL)
-		markup += "\n" + el->get_property_base (*color_by)
-			.get_string (color_by->get_format ());
+	display_identity.set_element (*el);
+	display_identity.show ();
 
-	Gtk::Label *name = new Gtk::Label ();
-	name->set_markup (markup);
-	name->show ();
-	display.pack_start (*Gtk::manage (name), Gtk::PACK_SHRINK);
+	if (display_shown != &markup)
+	{
+		display_name.set_markup (markup);
+		display_shown = &markup;
+	}
+	display_name.show ();
 }
 
 
@@ -325,6 +360,8 @@ TableTable::on_color_by_changed (PropertyBase* property)
 {
 	if (color_by == property) return;
 	color_by = property;
+	display_markup.clear ();
+	display_shown = NULL;
 	
 	legend.set_label (compose::ucompose (_("_Legend (<b>%1</b>)"),
 		(color_by != NULL) ? color_by->get_name () : _("None")));
@@ -440,21 +477,23 @@ TableTable::update_colorbar ()
 		result = table = NULL;
 	
 		FloatProperty *float_prop = CAST (color_by, FloatProperty);
-		if (float_prop != NULL && float_prop->is_scale_valid ())
+		if (float_prop != NULL && float_prop->is_scale_valid (*dataset))
 		{
 			Gtk::HBox *buttons = new Gtk::HBox (true, 2);
 
 			LegendButton *button = new LegendButton (ColorValue (0.0));
-			button->set_label (compose::ucompose1 (float_prop->get_minimum ()));
+			button->set_label (compose::ucompose1
+				(float_prop->get_minimum (*dataset)));
 			buttons->pack_start (*Gtk::manage (button));
 			
 			button = new LegendButton (ColorValue (0.5));
 			button->set_label (compose::ucompose1
-				(float_prop->get_medium (logarithmic.get_active ())));
+				(float_prop->get_medium (*dataset, logarithmic.get_active ())));
 			buttons->pack_start (*Gtk::manage (button));
 			
 			button = new LegendButton (ColorValue (1.0));
-			button->set_label (compose::ucompose1 (float_prop->get_maximum ()));
+			button->set_label (compose::ucompose1
+				(float_prop->get_maximum (*dataset)));
 			buttons->pack_start (*Gtk::manage (button));
 
 			button = new LegendButton (ColorValue (Q_UNK));
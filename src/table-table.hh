@@ -26,6 +26,8 @@
 #include "misc.hh"
 #include "buttons.hh"
 
+#include <map>
+#include <utility>
 #include <vector>
 #include <gtkmm/actiongroup.h>
 #include <gtkmm/adjustment.h>
@@ -72,7 +74,9 @@ private:
 
 	void populate_button_table ();
 	void update_colors ();
+	Dataset::Ptr dataset;
 	Gtk::Table button_table;
+	std::vector<ElementButton*> buttons;
 
 	void create_reference (const ustring& title, guint x1, guint y1,
 		guint x2, guint y2);
@@ -86,6 +90,11 @@ private:
 
 	void update_display ();
 	Gtk::HBox display;
+	ElementIdentity display_identity;
+	Gtk::Label display_name;
+	typedef std::map<std::pair<const Element*, int>, ustring> MarkupCache;
+	MarkupCache display_markup;
+	const ustring *display_shown;
 
 	void on_color_by_changed (PropertyBase* property);
 	PropertyBase *color_by;